@@ -0,0 +1,145 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - ARCache.cpp
+// ============================================================================
+
+#include "ARCache.h"
+#include "Config.h"
+#include "FrameClock.h"
+#include "SkillSync.h"
+
+#include <cstring>
+
+namespace MediumArmor::ARCache
+{
+
+    // Open addressing over a short run; a 400-item merchant list fits with
+    // room to spare.  Direct-mapped, two items sharing a slot evicted each
+    // other on every redraw.
+    constexpr UInt32 kDisplaySlots = 1024;  // power of two
+    constexpr UInt32 kDisplayProbe = 8;
+
+    struct DisplayKey
+    {
+        const void* form;
+        UInt32      baseAR;
+        UInt32      luck;
+        UInt32      condition;
+
+        bool operator==(const DisplayKey& other) const
+        {
+            return form == other.form && condition == other.condition &&
+                baseAR == other.baseAR && luck == other.luck;
+        }
+    };
+
+    struct DisplayEntry
+    {
+        DisplayKey key;
+        double     value;
+        bool       valid;
+    };
+
+    static DisplayEntry s_display[kDisplaySlots] = {};
+    static Stats        s_displayStats = {};
+    static UInt32       s_lastUseFrame = 0;
+    static UInt32       s_skillVersion = 0;
+
+    static UInt32 FloatBits(float f)
+    {
+        UInt32 bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        return bits;
+    }
+
+    static DisplayKey MakeKey(const void* form, UInt16 baseAR, float luck, float condition)
+    {
+        return { form, baseAR, FloatBits(luck), FloatBits(condition) };
+    }
+
+    static UInt32 SlotFor(const DisplayKey& key)
+    {
+        UInt32 h = static_cast<UInt32>(reinterpret_cast<uintptr_t>(key.form)) * 0x9E3779B1u;
+        h ^= key.condition * 0x85EBCA77u;
+        h ^= key.baseAR * 0xC2B2AE3Du;
+        h ^= key.luck * 0x27D4EB2Fu;
+
+        // Odd multipliers never move entropy down, and form pointers are
+        // aligned: mix the high bits into the slot bits.
+        h ^= h >> 16;
+        h *= 0x7FEB352Du;
+        return (h ^ (h >> 15)) & (kDisplaySlots - 1);
+    }
+
+    void ClearDisplay()
+    {
+        std::memset(s_display, 0, sizeof(s_display));
+        ++s_displayStats.clears;
+    }
+
+    // Ends the menu session if the skill changed or redraws stopped coming.
+    static void ValidateSession()
+    {
+        const UInt32 frame = FrameClock::Current();
+        const UInt32 skillVersion = SkillSync::Get().GetVersion();
+
+        if (skillVersion != s_skillVersion || frame - s_lastUseFrame > kARDisplayCacheIdleFrames)
+        {
+            ClearDisplay();
+            s_skillVersion = skillVersion;
+        }
+
+        s_lastUseFrame = frame;
+    }
+
+    bool LookupDisplay(const void* form, UInt16 baseAR, float luck, float condition, double& out)
+    {
+        ValidateSession();
+
+        const DisplayKey key = MakeKey(form, baseAR, luck, condition);
+        const UInt32 home = SlotFor(key);
+        for (UInt32 i = 0; i < kDisplayProbe; ++i)
+        {
+            const DisplayEntry& entry = s_display[(home + i) & (kDisplaySlots - 1)];
+            if (!entry.valid)
+                break;
+            if (entry.key == key)
+            {
+                ++s_displayStats.hits;
+                out = entry.value;
+                return true;
+            }
+        }
+
+        ++s_displayStats.misses;
+        return false;
+    }
+
+    void StoreDisplay(const void* form, UInt16 baseAR, float luck, float condition, double value)
+    {
+        const DisplayKey key = MakeKey(form, baseAR, luck, condition);
+        const UInt32 home = SlotFor(key);
+
+        // First free or matching slot in the run; the home slot if it is full.
+        DisplayEntry* target = &s_display[home];
+        for (UInt32 i = 0; i < kDisplayProbe; ++i)
+        {
+            DisplayEntry& entry = s_display[(home + i) & (kDisplaySlots - 1)];
+            if (!entry.valid || entry.key == key)
+            {
+                target = &entry;
+                break;
+            }
+        }
+
+        DisplayEntry& entry = *target;
+        entry.key = key;
+        entry.value = value;
+        entry.valid = true;
+    }
+
+    const Stats& GetDisplayStats()
+    {
+        return s_displayStats;
+    }
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+// ============================================================================
+//  MediumArmor OBSE Plugin - ARCache.h
+//
+//  Display AR cache for the Hook 3/Hook 4 inventory path.  Inventory and
+//  merchant menus recompute every listed item's AR on each redraw.  Hook 3
+//  remembers the medium form it classified; Hook 4 looks it up here by
+//  (form, condition), plus the base AR and luck it was passed, before any
+//  skill read or Calc_ArmorRating call.
+//
+//  The skill is not in the key: the cache lives for a "menu session" and
+//  is dropped when the medium skill changes and when no display lookup has
+//  happened for kARDisplayCacheIdleFrames (the menu closed; no redraws are
+//  arriving).  Hook 3's classification still runs per item - the condition
+//  is not known there - and is one class table probe.
+//
+//  The Hook 1 combat path (CalcMediumPieceAR) is not cached.  The engine
+//  sums an actor's pieces in sub_488CB0's caller, which is not hooked, and
+//  neither luck nor condition has a change signal, so any key would cost
+//  the same engine reads as the computation it guards; a hit would only
+//  save the Calc_ArmorRating call.
+// ============================================================================
+
+namespace MediumArmor::ARCache
+{
+	struct Stats
+	{
+		UInt32 hits;
+		UInt32 misses;
+		UInt32 clears;
+	};
+
+	bool  LookupDisplay(const void* form, UInt16 baseAR, float luck, float condition, double& out);
+	void  StoreDisplay(const void* form, UInt16 baseAR, float luck, float condition, double value);
+	void  ClearDisplay();
+
+	const Stats& GetDisplayStats();
+}
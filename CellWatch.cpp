@@ -0,0 +1,138 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - CellWatch.cpp
+// ============================================================================
+
+#include "CellWatch.h"
+#include "FrameClock.h"
+#include "Trace.h"
+
+#include "obse/GameAPI.h"
+#include "obse/GameData.h"
+#include "obse/GameForms.h"
+#include "obse/GameObjects.h"
+#include "obse/GameRTTI.h"
+
+namespace MediumArmor::CellWatch
+{
+
+    static Listener       s_listeners[kMaxListeners] = {};
+    static UInt32         s_listenerCount = 0;
+    static bool           s_listening = false;
+    static TESObjectCELL* s_cell = nullptr;
+
+    static TESObjectCELL* s_loaded[kMaxLoadedCells] = {};
+    static UInt32         s_loadedCount = 0;
+
+    static bool Contains(TESObjectCELL* const* cells, UInt32 count, const TESObjectCELL* cell)
+    {
+        for (UInt32 i = 0; i < count; ++i)
+        {
+            if (cells[i] == cell)
+                return true;
+        }
+        return false;
+    }
+
+    // The player's cell first, then the rest of the exterior grid.
+    static UInt32 CollectLoadedCells(TESObjectCELL* playerCell, TESObjectCELL** out)
+    {
+        UInt32 count = 0;
+        out[count++] = playerCell;
+        if (playerCell->IsInterior())
+            return count;
+
+        GridCellArray* grid = GridCellArray::GetSingleton();
+        if (!grid)
+            return count;
+
+        for (UInt32 x = 0; x < grid->size; ++x)
+        {
+            for (UInt32 y = 0; y < grid->size; ++y)
+            {
+                GridCellArray::GridEntry* entry = grid->GetGridEntry(x, y);
+                TESObjectCELL* cell = entry ? entry->cell : nullptr;
+                if (cell && cell != playerCell && count < kMaxLoadedCells)
+                    out[count++] = cell;
+            }
+        }
+        return count;
+    }
+
+    static void OnFrame(uint32_t frame)
+    {
+        PlayerCharacter* player = *g_thePlayer;
+        TESObjectCELL* cell = player ? player->parentCell : nullptr;
+        if (cell == s_cell || !cell)
+            return;
+
+        MA_TRACE_SCOPE("CellWatch_Changed");
+
+        TESObjectCELL* loaded[kMaxLoadedCells];
+        const UInt32 loadedCount = CollectLoadedCells(cell, loaded);
+
+        TESObjectCELL* attached[kMaxLoadedCells];
+        UInt32 attachedCount = 0;
+        for (UInt32 i = 0; i < loadedCount; ++i)
+        {
+            if (!Contains(s_loaded, s_loadedCount, loaded[i]))
+                attached[attachedCount++] = loaded[i];
+        }
+
+        TESObjectCELL* detached[kMaxLoadedCells];
+        UInt32 detachedCount = 0;
+        for (UInt32 i = 0; i < s_loadedCount; ++i)
+        {
+            if (!Contains(loaded, loadedCount, s_loaded[i]))
+                detached[detachedCount++] = s_loaded[i];
+        }
+
+        const Change change = { s_cell, cell, attached, attachedCount, detached, detachedCount };
+
+        // Listeners see the new set through IsLoaded().
+        s_cell = cell;
+        for (UInt32 i = 0; i < loadedCount; ++i)
+            s_loaded[i] = loaded[i];
+        s_loadedCount = loadedCount;
+
+        for (UInt32 i = 0; i < s_listenerCount; ++i)
+            s_listeners[i](change);
+    }
+
+    bool AddListener(Listener fn)
+    {
+        if (!fn || s_listenerCount == kMaxListeners)
+            return false;
+
+        if (!s_listening)
+            s_listening = FrameClock::AddListener(&OnFrame);
+        if (!s_listening)
+            return false;
+
+        s_listeners[s_listenerCount++] = fn;
+        return true;
+    }
+
+    TESObjectCELL* Current()
+    {
+        return s_cell;
+    }
+
+    bool IsLoaded(const TESObjectCELL* cell)
+    {
+        return cell && Contains(s_loaded, s_loadedCount, cell);
+    }
+
+    TESObjectCELL* CellOf(UInt32 refID)
+    {
+        TESForm* form = LookupFormByID(refID);
+        TESObjectREFR* refr = form ? OBLIVION_CAST(form, TESForm, TESObjectREFR) : nullptr;
+        return refr ? refr->parentCell : nullptr;
+    }
+
+    void Reset()
+    {
+        s_cell = nullptr;
+        s_loadedCount = 0;
+    }
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+// ============================================================================
+//  MediumArmor OBSE Plugin - CellWatch.h
+//
+//  Tracks the set of loaded cells from the plugin's own frames: the
+//  player's interior, or the exterior grid around the player (uGridsToLoad
+//  squared).  When the player's cell changes, registered listeners get the
+//  cells that entered the set and the cells that left it.  A walk across
+//  exterior cells attaches and detaches one row of the grid; a load door
+//  swaps the whole set.
+// ============================================================================
+
+class TESObjectCELL;
+
+namespace MediumArmor::CellWatch
+{
+	constexpr UInt32 kMaxLoadedCells = 121;     // uGridsToLoad up to 11
+	constexpr UInt32 kMaxListeners = 4;
+
+	struct Change
+	{
+		TESObjectCELL*        from;             // player's cell before; null after a load
+		TESObjectCELL*        to;
+		TESObjectCELL* const* attached;
+		UInt32                attachedCount;
+		TESObjectCELL* const* detached;
+		UInt32                detachedCount;
+
+		bool Detached(const void* cell) const
+		{
+			for (UInt32 i = 0; i < detachedCount; ++i)
+			{
+				if (detached[i] == cell)
+					return true;
+			}
+			return false;
+		}
+	};
+
+	typedef void (*Listener)(const Change& change);
+
+	bool           AddListener(Listener fn);
+
+	TESObjectCELL* Current();
+	bool           IsLoaded(const TESObjectCELL* cell);
+
+	// The reference's current cell; null if it is gone or not placed.
+	TESObjectCELL* CellOf(UInt32 refID);
+
+	// LoadGame: forget the loaded set without notifying.
+	void           Reset();
+}
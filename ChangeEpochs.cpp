@@ -0,0 +1,122 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - ChangeEpochs.cpp
+// ============================================================================
+
+#include "ChangeEpochs.h"
+#include "CellWatch.h"
+#include "FrameClock.h"
+#include "MediumArmor.h"
+#include "Trace.h"
+
+#include "obse/GameAPI.h"
+#include "obse/GameForms.h"
+#include "obse/GameObjects.h"
+#include "obse/GameRTTI.h"
+
+namespace MediumArmor::ChangeEpochs
+{
+
+    static Tracker s_tracker;
+    static bool    s_initialized = false;
+
+    // Resolves a watched refID; null if the reference is gone.
+    static Actor* Resolve(UInt32 refID)
+    {
+        TESForm* form = LookupFormByID(refID);
+        TESObjectREFR* refr = form ? OBLIVION_CAST(form, TESForm, TESObjectREFR) : nullptr;
+        if (!refr || !refr->IsActor())
+            return nullptr;
+        return static_cast<Actor*>(refr);
+    }
+
+    UInt32 Current()
+    {
+        return s_tracker.Current();
+    }
+
+    UInt32 SkillEpoch()
+    {
+        return s_tracker.SkillEpoch();
+    }
+
+    void NoteSkill(float value)
+    {
+        s_tracker.NoteSkill(value);
+    }
+
+    void NoteActor(Actor* actor, int mediumCount)
+    {
+        if (actor)
+            s_tracker.NoteActor(actor->refID, mediumCount, FrameClock::Current());
+    }
+
+    void ObserveCount(Actor* actor, int mediumCount)
+    {
+        if (actor)
+            s_tracker.Observe(actor->refID, mediumCount);
+    }
+
+    // A few watched actors per frame; the counts they take come back
+    // through ObserveCount.
+    static void OnFrame(uint32_t frame)
+    {
+        Actor* player = *g_thePlayer;
+        if (!player)
+            return;
+
+        MA_TRACE_SCOPE("ChangeEpochs_Refresh");
+
+        if (!s_tracker.IsWatched(player->refID))
+            s_tracker.NoteActor(player->refID, CountEquippedMediumArmor(player), frame);
+
+        s_tracker.RefreshSome(kRefreshPerFrame, [](UInt32 refID, int& count)
+            {
+                Actor* actor = Resolve(refID);
+                if (!actor)
+                    return false;
+                count = CountEquippedMediumArmor(actor);
+                return true;
+            });
+    }
+
+    // Actors left behind in detached cells stop being watched; the player
+    // never does.
+    static void OnLoadedCellsChanged(const CellWatch::Change& change)
+    {
+        if (!change.detachedCount)
+            return;
+
+        const UInt32 playerRefID = *g_thePlayer ? (*g_thePlayer)->refID : 0;
+        s_tracker.UnwatchIf([playerRefID](UInt32 refID)
+            {
+                return refID != playerRefID && !CellWatch::IsLoaded(CellWatch::CellOf(refID));
+            });
+    }
+
+    void Init()
+    {
+        if (s_initialized)
+            return;
+
+        s_initialized = FrameClock::AddListener(&OnFrame) &&
+            CellWatch::AddListener(&OnLoadedCellsChanged);
+        if (!s_initialized)
+            _ERROR("MediumArmor: change epochs could not register their listeners.");
+    }
+
+    bool HasChangesSince(UInt32 epoch)
+    {
+        return s_tracker.HasChangesSince(epoch);
+    }
+
+    UInt32 ActorsChangedSince(UInt32 epoch, ActorChange* out, UInt32 maxOut)
+    {
+        return s_tracker.ActorsChangedSince(epoch, out, maxOut);
+    }
+
+    void Clear()
+    {
+        s_tracker.ClearWatched();
+    }
+
+}
@@ -0,0 +1,239 @@
+#pragma once
+// ============================================================================
+//  MediumArmor OBSE Plugin - ChangeEpochs.h
+//
+//  Change epochs for script polling.  One counter only ever goes up; every
+//  change takes the next value.  The medium skill keeps the epoch of its
+//  last change, and so does each watched actor's equipped-medium count.
+//  A script remembers the epoch it last saw and asks for what changed
+//  after it, instead of re-reading every value every frame.
+//
+//  Actors are watched from their first GetEquippedMediumCount or
+//  IsWearingMediumArmor call (the player always).  At most kMaxWatched;
+//  past that the actor asked about longest ago is replaced.  An actor stops
+//  being watched when its cell detaches or its reference is gone.
+//
+//  There is no equip signal to bump an actor's epoch from, so counts come
+//  from two places: every CountEquippedMediumArmor call on a watched actor
+//  (commands, MediumArmorAPI, the warm-up) records what it found, and each
+//  plugin frame re-counts kRefreshPerFrame watched actors in turn, so a
+//  change nobody asked about shows up within kMaxWatched / kRefreshPerFrame
+//  frames.  Polling for changes only reads the tracker.
+//
+//  Tracker is engine-independent; ChangeEpochs.cpp binds it to the game
+//  (actor lookup, CountEquippedMediumArmor, FrameClock, CellWatch).
+// ============================================================================
+
+#include <cstdint>
+
+class Actor;
+
+namespace MediumArmor::ChangeEpochs
+{
+	constexpr uint32_t kMaxWatched = 32;
+	constexpr uint32_t kRefreshPerFrame = 4;
+
+	struct ActorChange
+	{
+		uint32_t refID;
+		int      mediumCount;
+		uint32_t epoch;
+	};
+
+	class Tracker
+	{
+	public:
+		uint32_t Current() const { return m_epoch; }
+		uint32_t SkillEpoch() const { return m_skillEpoch; }
+		uint32_t WatchedCount() const { return m_watchedCount; }
+
+		void NoteSkill(float value)
+		{
+			if (value == m_skill)
+				return;
+
+			m_skill = value;
+			m_skillEpoch = Bump();
+		}
+
+		// Records the count and watches the actor.
+		void NoteActor(uint32_t refID, int mediumCount, uint32_t frame)
+		{
+			Watched& entry = FindOrWatch(refID, mediumCount, frame);
+			entry.askedFrame = frame;
+			Update(entry, mediumCount);
+		}
+
+		bool IsWatched(uint32_t refID) const
+		{
+			return Find(refID) != nullptr;
+		}
+
+		// A count taken for some other reason; recorded only if the actor
+		// is watched, without watching it or counting as asked.
+		void Observe(uint32_t refID, int mediumCount)
+		{
+			if (Watched* entry = Find(refID))
+				Update(*entry, mediumCount);
+		}
+
+		// Re-reads up to maxReads watched actors, carrying on from where
+		// the last call stopped.  countOf(refID, outCount) returns false
+		// if the actor is gone, which stops watching it.
+		template <typename CountOf>
+		void RefreshSome(uint32_t maxReads, CountOf&& countOf)
+		{
+			for (uint32_t reads = 0; reads < maxReads && m_watchedCount; ++reads)
+			{
+				if (m_cursor >= m_watchedCount)
+					m_cursor = 0;
+
+				int count = 0;
+				if (countOf(m_watched[m_cursor].refID, count))
+					Update(m_watched[m_cursor++], count);
+				else
+					Unwatch(m_cursor);
+			}
+		}
+
+		// Stops watching every actor for which drop(refID) is true.
+		template <typename Pred>
+		void UnwatchIf(Pred&& drop)
+		{
+			for (uint32_t i = 0; i < m_watchedCount;)
+			{
+				if (drop(m_watched[i].refID))
+					Unwatch(i);
+				else
+					++i;
+			}
+		}
+
+		bool HasChangesSince(uint32_t epoch) const
+		{
+			if (epoch > m_epoch)
+				epoch = 0;
+			return m_skillEpoch > epoch || m_latestActorEpoch > epoch;
+		}
+
+		uint32_t ActorsChangedSince(uint32_t epoch, ActorChange* out, uint32_t maxOut) const
+		{
+			if (epoch > m_epoch)
+				epoch = 0;
+
+			uint32_t count = 0;
+			for (uint32_t i = 0; i < m_watchedCount && count < maxOut; ++i)
+			{
+				const Watched& entry = m_watched[i];
+				if (entry.epoch > epoch)
+					out[count++] = { entry.refID, entry.mediumCount, entry.epoch };
+			}
+			return count;
+		}
+
+		// Forgets the watched actors; the counter keeps going, so epochs
+		// scripts hold from before stay in the past.
+		void ClearWatched()
+		{
+			m_watchedCount = 0;
+			m_cursor = 0;
+			m_latestActorEpoch = 0;
+		}
+
+	private:
+		struct Watched
+		{
+			uint32_t refID;
+			int      mediumCount;
+			uint32_t epoch;
+			uint32_t askedFrame;    // last NoteActor, for replacement
+		};
+
+		uint32_t Bump()
+		{
+			return ++m_epoch;
+		}
+
+		Watched* Find(uint32_t refID)
+		{
+			for (uint32_t i = 0; i < m_watchedCount; ++i)
+			{
+				if (m_watched[i].refID == refID)
+					return &m_watched[i];
+			}
+			return nullptr;
+		}
+
+		const Watched* Find(uint32_t refID) const
+		{
+			return const_cast<Tracker*>(this)->Find(refID);
+		}
+
+		// The last entry moves into the gap.  Its change, if any, stays
+		// reported; an unwatched actor's last change simply isn't listed.
+		void Unwatch(uint32_t index)
+		{
+			m_watched[index] = m_watched[--m_watchedCount];
+		}
+
+		void Update(Watched& entry, int mediumCount)
+		{
+			if (entry.mediumCount == mediumCount)
+				return;
+
+			entry.mediumCount = mediumCount;
+			entry.epoch = m_latestActorEpoch = Bump();
+		}
+
+		Watched& FindOrWatch(uint32_t refID, int mediumCount, uint32_t frame)
+		{
+			Watched* oldest = &m_watched[0];
+			for (uint32_t i = 0; i < m_watchedCount; ++i)
+			{
+				if (m_watched[i].refID == refID)
+					return m_watched[i];
+				if (m_watched[i].askedFrame < oldest->askedFrame)
+					oldest = &m_watched[i];
+			}
+
+			Watched& entry = m_watchedCount < kMaxWatched ? m_watched[m_watchedCount++] : *oldest;
+			entry = { refID, mediumCount, Bump(), frame };
+			m_latestActorEpoch = entry.epoch;
+			return entry;
+		}
+
+		uint32_t m_epoch = 1;
+		uint32_t m_skillEpoch = 1;
+		float    m_skill = 0.0f;
+		uint32_t m_latestActorEpoch = 0;
+
+		Watched  m_watched[kMaxWatched] = {};
+		uint32_t m_watchedCount = 0;
+		uint32_t m_cursor = 0;          // next RefreshSome read
+	};
+
+	// Latest epoch handed out.  Never 0, so 0 means "before anything".
+	UInt32 Current();
+
+	UInt32 SkillEpoch();
+	void   NoteSkill(float value);
+
+	// Registers the per-frame refresh and the cell listener.
+	void   Init();
+
+	// From the polling commands: records the count and watches the actor.
+	void   NoteActor(Actor* actor, int mediumCount);
+
+	// From CountEquippedMediumArmor: records the count if the actor is
+	// watched.
+	void   ObserveCount(Actor* actor, int mediumCount);
+
+	// Epochs newer than Current() (from an earlier session) count as 0.
+	bool   HasChangesSince(UInt32 epoch);
+
+	// Copies the watched actors changed after `epoch`; returns how many.
+	UInt32 ActorsChangedSince(UInt32 epoch, ActorChange* out, UInt32 maxOut);
+
+	// LoadGame: the watched refs and counts belong to the old session.
+	void   Clear();
+}
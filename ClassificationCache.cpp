@@ -0,0 +1,185 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - ClassificationCache.cpp
+// ============================================================================
+
+#include "ClassificationCache.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <cstdio>
+#endif
+
+namespace MediumArmor::ClassificationCache
+{
+
+    uint64_t HashBytes(const void* data, size_t size, uint64_t seed)
+    {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        uint64_t hash = seed;
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= p[i];
+            hash *= 0x100000001B3ull;
+        }
+        return hash;
+    }
+
+    uint64_t HashString(const char* str, uint64_t seed)
+    {
+        // Include the terminator so "ab"+"c" and "a"+"bc" differ.
+        return str ? HashBytes(str, std::strlen(str) + 1, seed) : HashBytes("", 1, seed);
+    }
+
+    uint64_t FingerprintSeed(uint32_t classifierVersion)
+    {
+        const uint32_t versions[2] = { kFormatVersion, classifierVersion };
+        return HashBytes(versions, sizeof(versions));
+    }
+
+    uint32_t Checksum(const uint32_t* formIDs, uint32_t count)
+    {
+        const uint64_t hash = HashBytes(formIDs, count * sizeof(uint32_t));
+        return static_cast<uint32_t>(hash ^ (hash >> 32));
+    }
+
+    std::vector<uint8_t> Serialize(uint64_t fingerprint, const uint32_t* formIDs, uint32_t count)
+    {
+        Header header = {};
+        header.magic = kMagic;
+        header.version = kFormatVersion;
+        header.fingerprint = fingerprint;
+        header.count = count;
+        header.checksum = Checksum(formIDs, count);
+
+        std::vector<uint8_t> image(sizeof(Header) + count * sizeof(uint32_t));
+        std::memcpy(image.data(), &header, sizeof(Header));
+        if (count)
+            std::memcpy(image.data() + sizeof(Header), formIDs, count * sizeof(uint32_t));
+        return image;
+    }
+
+    bool Validate(const void* image, size_t size, uint64_t fingerprint,
+        const uint32_t** outFormIDs, uint32_t* outCount)
+    {
+        if (!image || size < sizeof(Header))
+            return false;
+
+        Header header;
+        std::memcpy(&header, image, sizeof(Header));
+
+        if (header.magic != kMagic || header.version != kFormatVersion)
+            return false;
+        if (header.fingerprint != fingerprint)
+            return false;
+        if (size != sizeof(Header) + static_cast<size_t>(header.count) * sizeof(uint32_t))
+            return false;
+
+        const uint32_t* formIDs = reinterpret_cast<const uint32_t*>(
+            static_cast<const uint8_t*>(image) + sizeof(Header));
+
+        for (uint32_t i = 1; i < header.count; ++i)
+        {
+            if (formIDs[i - 1] >= formIDs[i])
+                return false;
+        }
+
+        if (Checksum(formIDs, header.count) != header.checksum)
+            return false;
+
+        if (outFormIDs)
+            *outFormIDs = formIDs;
+        if (outCount)
+            *outCount = header.count;
+        return true;
+    }
+
+#ifdef _WIN32
+
+    static HANDLE      s_file = INVALID_HANDLE_VALUE;
+    static HANDLE      s_mapping = nullptr;
+    static const void* s_view = nullptr;
+
+    uint64_t HashFileStamp(const char* path, uint64_t seed)
+    {
+        seed = HashString(path, seed);
+
+        WIN32_FILE_ATTRIBUTE_DATA attr;
+        if (!GetFileAttributesExA(path, GetFileExInfoStandard, &attr))
+            return HashString("<missing>", seed);
+
+        seed = HashBytes(&attr.nFileSizeLow, sizeof(attr.nFileSizeLow), seed);
+        seed = HashBytes(&attr.nFileSizeHigh, sizeof(attr.nFileSizeHigh), seed);
+        return HashBytes(&attr.ftLastWriteTime, sizeof(attr.ftLastWriteTime), seed);
+    }
+
+    void Unmap()
+    {
+        if (s_view)
+            UnmapViewOfFile(s_view);
+        if (s_mapping)
+            CloseHandle(s_mapping);
+        if (s_file != INVALID_HANDLE_VALUE)
+            CloseHandle(s_file);
+
+        s_view = nullptr;
+        s_mapping = nullptr;
+        s_file = INVALID_HANDLE_VALUE;
+    }
+
+    bool Map(const char* path, uint64_t fingerprint, const uint32_t** outFormIDs, uint32_t* outCount)
+    {
+        Unmap();
+
+        s_file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (s_file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(s_file, &size) || size.QuadPart < static_cast<LONGLONG>(sizeof(Header)))
+        {
+            Unmap();
+            return false;
+        }
+
+        s_mapping = CreateFileMappingA(s_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        s_view = s_mapping ? MapViewOfFile(s_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+        if (!s_view || !Validate(s_view, static_cast<size_t>(size.QuadPart), fingerprint, outFormIDs, outCount))
+        {
+            Unmap();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool Write(const char* path, uint64_t fingerprint, const uint32_t* formIDs, uint32_t count)
+    {
+        const std::vector<uint8_t> image = Serialize(fingerprint, formIDs, count);
+
+        // Write beside the target and swap in, so a crash never leaves a
+        // half-written cache that happens to carry a valid header.
+        char tempPath[MAX_PATH];
+        if (std::snprintf(tempPath, sizeof(tempPath), "%s.tmp", path) >= static_cast<int>(sizeof(tempPath)))
+            return false;
+
+        std::FILE* f = std::fopen(tempPath, "wb");
+        if (!f)
+            return false;
+
+        const bool written = std::fwrite(image.data(), 1, image.size(), f) == image.size();
+        if (std::fclose(f) != 0 || !written)
+        {
+            DeleteFileA(tempPath);
+            return false;
+        }
+
+        return MoveFileExA(tempPath, path, MOVEFILE_REPLACE_EXISTING) != 0;
+    }
+
+#endif
+
+}
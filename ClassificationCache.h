@@ -0,0 +1,68 @@
+#pragma once
+// ============================================================================
+//  MediumArmor OBSE Plugin - ClassificationCache.h
+//
+//  On-disk copy of the medium classification table, keyed by a fingerprint
+//  of the cache and classifier versions, the load order and the keyword
+//  config.  Layout (little-endian):
+//
+//      Header  { magic, version, fingerprint, count, checksum }
+//      UInt32  formIDs[count]     sorted, strictly ascending
+//
+//  The format/validation half is platform-neutral; mapping the file is
+//  Windows-only and keeps the view open so the table can point into it.
+// ============================================================================
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MediumArmor::ClassificationCache
+{
+	constexpr uint32_t kMagic = 0x4341414D;  // 'MAAC'
+	constexpr uint32_t kFormatVersion = 1;
+
+	// Bump when the rules deciding what is medium change (keyword matching,
+	// which forms are scanned), so caches built by an older plugin are
+	// rebuilt even though the load order and config are the same.
+	constexpr uint32_t kClassifierVersion = 1;
+
+	constexpr uint64_t kFnvOffset = 0xCBF29CE484222325ull;
+
+	struct Header
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint64_t fingerprint;
+		uint32_t count;
+		uint32_t checksum;
+	};
+	static_assert(sizeof(Header) == 24, "cache header layout changed");
+
+	uint64_t HashBytes(const void* data, size_t size, uint64_t seed = kFnvOffset);
+	uint64_t HashString(const char* str, uint64_t seed = kFnvOffset);
+
+	// Starting hash for a fingerprint: the format and classifier versions.
+	uint64_t FingerprintSeed(uint32_t classifierVersion = kClassifierVersion);
+
+	uint32_t Checksum(const uint32_t* formIDs, uint32_t count);
+
+	std::vector<uint8_t> Serialize(uint64_t fingerprint, const uint32_t* formIDs, uint32_t count);
+
+	// Checks magic, version, fingerprint, size, ordering and checksum.
+	bool Validate(const void* image, size_t size, uint64_t fingerprint,
+		const uint32_t** outFormIDs, uint32_t* outCount);
+
+#ifdef _WIN32
+	// Folds a file's size and last-write time into `seed`; missing files
+	// hash as such, so adding one later still changes the result.
+	uint64_t HashFileStamp(const char* path, uint64_t seed);
+
+	// Maps `path` and validates it.  On success the view stays mapped until
+	// Unmap() and *outFormIDs points into it.
+	bool Map(const char* path, uint64_t fingerprint, const uint32_t** outFormIDs, uint32_t* outCount);
+	void Unmap();
+
+	bool Write(const char* path, uint64_t fingerprint, const uint32_t* formIDs, uint32_t count);
+#endif
+}
@@ -0,0 +1,48 @@
+#pragma once
+// ============================================================================
+//  MediumArmor OBSE Plugin - Classifier.h
+//
+//  The medium-armour rule, apart from the engine: a form from a plugin file
+//  is medium if it is in the published class table; a runtime form (mod
+//  index 0xFF), or any form before the table is built, goes to the keyword
+//  test.  The caller supplies that test - KeywordAPI, then the editor ID,
+//  in the plugin; the editor ID alone in tools/BattleBench.
+//
+//  Platform-neutral; tools/BattleBench builds it as is.
+// ============================================================================
+
+#include "MediumArmorAPI.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace MediumArmor::Classifier
+{
+	// Forms created at runtime (mod index 0xFF) are never in the table.
+	inline bool IsDynamicFormID(uint32_t formID)
+	{
+		return (formID >> 24) == 0xFF;
+	}
+
+	inline bool IsInTable(const MediumArmorClassTable& table, uint32_t formID)
+	{
+		const uint32_t* end = table.formIDs + table.count;
+		return std::binary_search(table.formIDs, end, formID);
+	}
+
+	inline bool EditorIDHasKeyword(const char* editorID, const char* keyword)
+	{
+		return editorID && keyword && std::strstr(editorID, keyword) != nullptr;
+	}
+
+	// hasKeyword() is only called when the table can't answer.
+	template <typename KeywordTest>
+	bool IsMedium(const MediumArmorClassTable& table, uint32_t formID, KeywordTest&& hasKeyword)
+	{
+		if (table.generation != 0 && !IsDynamicFormID(formID))
+			return IsInTable(table, formID);
+
+		return hasKeyword();
+	}
+}
@@ -1,6 +1,13 @@
 #include "Commands.h"
 #include "MediumArmor.h"
 #include "Config.h"
+#include "Trace.h"
+#include "HookControl.h"
+#include "ARCache.h"
+#include "TierIndex.h"
+#include "WarmUp.h"
+#include "ChangeEpochs.h"
+#include "Timing.h"
 
 #include "obse/GameAPI.h"
 #include "obse/GameForms.h"
@@ -8,6 +15,9 @@
 #include "obse/ParamInfos.h"
 #include "obse/CommandTable.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace MediumArmor
 {
     static ParamInfo kParams_OneFloat[] =
@@ -25,9 +35,35 @@ namespace MediumArmor
         { "actorRef", kParamType_Actor, 1 },
     };
 
+    static ParamInfo kParams_OneInt[] =
+    {
+        { "int", kParamType_Integer, 0 },
+    };
+
+    static ParamInfo kParams_TwoInts[] =
+    {
+        { "int", kParamType_Integer, 0 },
+        { "int", kParamType_Integer, 0 },
+    };
+
+    static ParamInfo kParams_OneIntOneOptionalInt[] =
+    {
+        { "int", kParamType_Integer, 0 },
+        { "int", kParamType_Integer, 1 },
+    };
+
+    static OBSEArrayVarInterface* s_arrayInterface = nullptr;
+
+    static ParamInfo kParams_OneOptionalInt[] =
+    {
+        { "int", kParamType_Integer, 1 },
+    };
+
 
     static bool Cmd_GetMediumArmorSkill_Execute(COMMAND_ARGS)
     {
+        MA_TRACE_SCOPE("Cmd_GetMediumArmorSkill");
+
         *result = static_cast<double>(GetMediumArmorSkill());
         if (IsConsoleMode())
             Console_Print("GetMediumArmorSkill >> %.2f", *result);
@@ -36,6 +72,8 @@ namespace MediumArmor
 
     static bool Cmd_SetMediumArmorSkill_Execute(COMMAND_ARGS)
     {
+        MA_TRACE_SCOPE("Cmd_SetMediumArmorSkill");
+
         float value = 0.0f;
         if (!ExtractArgs(PASS_EXTRACT_ARGS, &value))
             return true;
@@ -49,6 +87,8 @@ namespace MediumArmor
 
     static bool Cmd_ModMediumArmorSkill_Execute(COMMAND_ARGS)
     {
+        MA_TRACE_SCOPE("Cmd_ModMediumArmorSkill");
+
         float delta = 0.0f;
         if (!ExtractArgs(PASS_EXTRACT_ARGS, &delta))
             return true;
@@ -63,6 +103,8 @@ namespace MediumArmor
 
     static bool Cmd_IsMediumArmor_Execute(COMMAND_ARGS)
     {
+        MA_TRACE_SCOPE("Cmd_IsMediumArmor");
+
         *result = 0.0;
         TESForm* form = nullptr;
 
@@ -83,6 +125,8 @@ namespace MediumArmor
 
     static bool Cmd_GetEquippedMediumCount_Execute(COMMAND_ARGS)
     {
+        MA_TRACE_SCOPE("Cmd_GetEquippedMediumCount");
+
         *result = 0.0;
         Actor* actor = nullptr;
 
@@ -98,7 +142,11 @@ namespace MediumArmor
         }
 
         if (actor)
-            *result = static_cast<double>(CountEquippedMediumArmor(actor));
+        {
+            const int count = CountEquippedMediumArmor(actor);
+            ChangeEpochs::NoteActor(actor, count);
+            *result = static_cast<double>(count);
+        }
 
         if (IsConsoleMode())
             Console_Print("GetEquippedMediumCount >> %d", static_cast<int>(*result));
@@ -107,6 +155,8 @@ namespace MediumArmor
 
     static bool Cmd_IsWearingMediumArmor_Execute(COMMAND_ARGS)
     {
+        MA_TRACE_SCOPE("Cmd_IsWearingMediumArmor");
+
         *result = 0.0;
         Actor* actor = nullptr;
 
@@ -121,14 +171,310 @@ namespace MediumArmor
                 actor = *g_thePlayer;
         }
 
-        if (actor && IsWearingMediumArmor(actor))
-            *result = 1.0;
+        if (actor)
+        {
+            const int count = CountEquippedMediumArmor(actor);
+            ChangeEpochs::NoteActor(actor, count);
+            *result = count > 0 ? 1.0 : 0.0;
+        }
 
         if (IsConsoleMode())
             Console_Print("IsWearingMediumArmor >> %d", static_cast<int>(*result));
         return true;
     }
 
+    static bool Cmd_StartMediumArmorTrace_Execute(COMMAND_ARGS)
+    {
+        *result = Trace::Start() ? 1.0 : 0.0;
+        if (IsConsoleMode())
+            Console_Print("StartMediumArmorTrace >> %s", *result != 0.0 ? "capturing" : "already capturing");
+        return true;
+    }
+
+    static bool Cmd_StopMediumArmorTrace_Execute(COMMAND_ARGS)
+    {
+        *result = 0.0;
+        if (!Trace::IsCapturing())
+        {
+            if (IsConsoleMode())
+                Console_Print("StopMediumArmorTrace >> not capturing");
+            return true;
+        }
+
+        Trace::Stop();
+        if (Trace::Export(kTraceOutputPath))
+            *result = 1.0;
+
+        if (IsConsoleMode())
+            Console_Print("StopMediumArmorTrace >> %u events (%u dropped) -> %s",
+                Trace::GetRecordedCount(), Trace::GetDroppedCount(),
+                *result != 0.0 ? kTraceOutputPath : "write failed");
+        return true;
+    }
+
+    static bool Cmd_SetMediumArmorHookEnabled_Execute(COMMAND_ARGS)
+    {
+        MA_TRACE_SCOPE("Cmd_SetMediumArmorHookEnabled");
+
+        *result = 0.0;
+        UInt32 hook = 0;
+        UInt32 enabled = 0;
+
+        if (!ExtractArgs(PASS_EXTRACT_ARGS, &hook, &enabled))
+            return true;
+
+        if (HookControl::SetEnabled(hook, enabled != 0))
+            *result = 1.0;
+
+        if (IsConsoleMode())
+        {
+            for (UInt32 i = 0; i < HookControl::kHook_Count; ++i)
+                Console_Print("%u %-24s %s  calls=%u", i, HookControl::GetName(i),
+                    !HookControl::IsToggleable(i) ? "fix" : HookControl::IsEnabled(i) ? "on " : "off",
+                    HookControl::GetCallCount(i));
+        }
+        return true;
+    }
+
+    static bool Cmd_SampleMediumArmorHook_Execute(COMMAND_ARGS)
+    {
+        MA_TRACE_SCOPE("Cmd_SampleMediumArmorHook");
+
+        *result = 0.0;
+        UInt32 hook = 0;
+        UInt32 windows = 20;
+
+        if (!ExtractArgs(PASS_EXTRACT_ARGS, &hook, &windows))
+            return true;
+
+        if (HookControl::StartSampling(hook, windows))
+            *result = 1.0;
+
+        if (IsConsoleMode())
+            Console_Print("SampleMediumArmorHook >> %s %s (%u x %u ms)", HookControl::GetName(hook),
+                *result != 0.0 ? "sampling" : "not started", windows, kSampleWindowMs);
+        return true;
+    }
+
+    static bool Cmd_GetMediumArmorARCacheStats_Execute(COMMAND_ARGS)
+    {
+        MA_TRACE_SCOPE("Cmd_GetMediumArmorARCacheStats");
+
+        *result = 0.0;
+
+        const ARCache::Stats& display = ARCache::GetDisplayStats();
+        const UInt32 lookups = display.hits + display.misses;
+        if (lookups)
+            *result = 100.0 * display.hits / lookups;
+
+        if (IsConsoleMode())
+            Console_Print("Display AR cache >> %u hits, %u misses (%.1f%%), %u clears",
+                display.hits, display.misses, *result, display.clears);
+        return true;
+    }
+
+    static bool Cmd_GetMediumArmorWarmUpStats_Execute(COMMAND_ARGS)
+    {
+        MA_TRACE_SCOPE("Cmd_GetMediumArmorWarmUpStats");
+
+        *result = 0.0;
+        UInt32 reset = 0;
+
+        if (!ExtractArgs(PASS_EXTRACT_ARGS, &reset))
+            return true;
+
+        const WarmUp::Stats& stats = WarmUp::GetStats();
+        *result = static_cast<double>(WarmUp::GetPending());
+
+        if (IsConsoleMode())
+        {
+            const WearCountStats& wear = GetWearCountStats();
+            Console_Print("Wear warm-up >> %s, budget %u us/frame, queue depth %u, %u pending",
+                WarmUp::IsEnabled() ? "on" : "off", WarmUp::GetBudgetUs(), WarmUp::GetQueueDepth(),
+                WarmUp::GetPending());
+            Console_Print("  %u queued, %u dropped, %u scanned, %u gone",
+                stats.queued, stats.dropped, stats.scanned, stats.gone);
+            Console_Print("  %u busy frames, %.1f us average, %u us max",
+                stats.busyFrames, stats.busyFrames ? stats.totalNs / 1e3 / stats.busyFrames : 0.0, stats.maxFrameUs);
+            Console_Print("  CountEquippedMediumArmor: %u counts, %.1f entries walked per count",
+                wear.counts, wear.counts ? static_cast<double>(wear.entries) / wear.counts : 0.0);
+        }
+
+        if (reset)
+            WarmUp::ResetStats();
+        return true;
+    }
+
+    // Returns the tier's forms (optionally one mod's) as an array in one call.
+    // From the console, prints the whole call's time: query, form lookups
+    // and array creation.
+    static bool ReturnTierArray(const char* name, UInt32 tier, SInt32 modIndex, Script* scriptObj, double* result)
+    {
+        if (!s_arrayInterface || !TierIndex::IsBuilt())
+            return true;
+
+        const UInt64 start = Timing::NowNs();
+        const UInt32* ids = nullptr;
+        const UInt32 count = TierIndex::Query(tier, modIndex, &ids);
+
+        std::vector<OBSEArrayVarInterface::Element> elements;
+        elements.reserve(count);
+        for (UInt32 i = 0; i < count; ++i)
+        {
+            if (TESForm* form = LookupFormByID(ids[i]))
+                elements.emplace_back(form);
+        }
+
+        OBSEArrayVarInterface::Array* arr = s_arrayInterface->CreateArray(
+            elements.data(), static_cast<UInt32>(elements.size()), scriptObj);
+        s_arrayInterface->AssignCommandResult(arr, result);
+
+        if (IsConsoleMode())
+            Console_Print("%s >> %u forms in %.3f ms", name,
+                static_cast<UInt32>(elements.size()), (Timing::NowNs() - start) / 1e6);
+        return true;
+    }
+
+    static bool Cmd_ListMediumArmor_Execute(COMMAND_ARGS)
+    {
+        MA_TRACE_SCOPE("Cmd_ListMediumArmor");
+
+        *result = 0.0;
+        SInt32 modIndex = TierIndex::kAllMods;
+
+        if (!ExtractArgs(PASS_EXTRACT_ARGS, &modIndex))
+            return true;
+
+        return ReturnTierArray("ListMediumArmor", TierIndex::kTier_Medium, modIndex, scriptObj, result);
+    }
+
+    static bool Cmd_ListArmorByTier_Execute(COMMAND_ARGS)
+    {
+        MA_TRACE_SCOPE("Cmd_ListArmorByTier");
+
+        *result = 0.0;
+        UInt32 tier = 0;
+        SInt32 modIndex = TierIndex::kAllMods;
+
+        if (!ExtractArgs(PASS_EXTRACT_ARGS, &tier, &modIndex))
+            return true;
+
+        return ReturnTierArray("ListArmorByTier", tier, modIndex, scriptObj, result);
+    }
+
+    // Debug: the per-form IsMediumArmor loop a script runs without the
+    // index, against the medium query plus the form lookups ListMediumArmor
+    // does, best of N passes each.  Returns how many times faster the index
+    // is; 0 if the two disagree on the count.
+    static bool Cmd_CompareMediumArmorIndex_Execute(COMMAND_ARGS)
+    {
+        MA_TRACE_SCOPE("Cmd_CompareMediumArmorIndex");
+
+        *result = 0.0;
+        UInt32 passes = 10;
+
+        if (!ExtractArgs(PASS_EXTRACT_ARGS, &passes) || !TierIndex::IsBuilt())
+            return true;
+        passes = std::clamp<UInt32>(passes, 1, 1000);
+
+        UInt64 loopNs = ~0ull;
+        UInt64 indexNs = ~0ull;
+        UInt32 loopCount = 0;
+        UInt32 indexCount = 0;
+        for (UInt32 pass = 0; pass < passes; ++pass)
+        {
+            UInt64 start = Timing::NowNs();
+            loopCount = 0;
+            ForEachArmorForm([&loopCount](TESForm* form)
+                {
+                    if (IsMediumArmor(form))
+                        ++loopCount;
+                });
+            loopNs = std::min(loopNs, Timing::NowNs() - start);
+
+            start = Timing::NowNs();
+            const UInt32* ids = nullptr;
+            const UInt32 count = TierIndex::Query(TierIndex::kTier_Medium, TierIndex::kAllMods, &ids);
+            indexCount = 0;
+            for (UInt32 i = 0; i < count; ++i)
+                indexCount += LookupFormByID(ids[i]) ? 1 : 0;
+            indexNs = std::min(indexNs, Timing::NowNs() - start);
+        }
+
+        if (loopCount == indexCount)
+            *result = static_cast<double>(loopNs) / std::max<UInt64>(indexNs, 1);
+
+        if (IsConsoleMode())
+            Console_Print("CompareMediumArmorIndex >> per-form loop %.3f ms (%u), index %.3f ms (%u), best of %u",
+                loopNs / 1e6, loopCount, indexNs / 1e6, indexCount, passes);
+        return true;
+    }
+
+    // Nothing changed: returns 0 without building an array, so a polling
+    // loop costs one command call.  Otherwise a string map:
+    //   "epoch"  -> epoch to pass next time
+    //   "skill"  -> medium skill, only if it changed
+    //   "actors" -> watched actors whose equipped-medium count changed
+    //   "counts" -> their counts, same order (IsWearing is count > 0)
+    static bool Cmd_GetMediumArmorChangesSince_Execute(COMMAND_ARGS)
+    {
+        MA_TRACE_SCOPE("Cmd_GetMediumArmorChangesSince");
+
+        *result = 0.0;
+        UInt32 since = 0;
+
+        if (!ExtractArgs(PASS_EXTRACT_ARGS, &since))
+            return true;
+
+        if (!ChangeEpochs::HasChangesSince(since))
+        {
+            if (IsConsoleMode())
+                Console_Print("GetMediumArmorChangesSince >> nothing since %u (epoch %u)", since, ChangeEpochs::Current());
+            return true;
+        }
+
+        ChangeEpochs::ActorChange changes[ChangeEpochs::kMaxWatched];
+        const UInt32 changed = ChangeEpochs::ActorsChangedSince(since, changes, ChangeEpochs::kMaxWatched);
+        const bool skillChanged = ChangeEpochs::SkillEpoch() > since || since > ChangeEpochs::Current();
+
+        if (IsConsoleMode())
+        {
+            Console_Print("GetMediumArmorChangesSince >> epoch %u, %u actor(s)%s",
+                ChangeEpochs::Current(), changed, skillChanged ? ", skill" : "");
+            for (UInt32 i = 0; i < changed; ++i)
+                Console_Print("  %08X  %d medium (epoch %u)", changes[i].refID, changes[i].mediumCount, changes[i].epoch);
+        }
+
+        if (!s_arrayInterface)
+            return true;
+
+        std::vector<OBSEArrayVarInterface::Element> actors;
+        std::vector<OBSEArrayVarInterface::Element> counts;
+        actors.reserve(changed);
+        counts.reserve(changed);
+        for (UInt32 i = 0; i < changed; ++i)
+        {
+            if (TESForm* form = LookupFormByID(changes[i].refID))
+            {
+                actors.emplace_back(form);
+                counts.emplace_back(static_cast<double>(changes[i].mediumCount));
+            }
+        }
+
+        const char* keys[4] = { "epoch", "actors", "counts", "skill" };
+        OBSEArrayVarInterface::Element values[4] =
+        {
+            static_cast<double>(ChangeEpochs::Current()),
+            s_arrayInterface->CreateArray(actors.data(), static_cast<UInt32>(actors.size()), scriptObj),
+            s_arrayInterface->CreateArray(counts.data(), static_cast<UInt32>(counts.size()), scriptObj),
+            static_cast<double>(GetMediumArmorSkill()),
+        };
+
+        OBSEArrayVarInterface::Array* map = s_arrayInterface->CreateStringMap(keys, values, skillChanged ? 4 : 3, scriptObj);
+        s_arrayInterface->AssignCommandResult(map, result);
+        return true;
+    }
+
     CommandInfo kCommandInfo_GetMediumArmorSkill =
     {
         "GetMediumArmorSkill",
@@ -201,4 +547,147 @@ namespace MediumArmor
         HANDLER(Cmd_IsWearingMediumArmor_Execute)
     };
 
+    CommandInfo kCommandInfo_StartMediumArmorTrace =
+    {
+        "StartMediumArmorTrace",
+        "",
+        kCmd_StartMediumArmorTrace,
+        "Starts recording hook/command spans for a Chrome trace-event export.",
+        0,
+        0,
+        nullptr,
+        HANDLER(Cmd_StartMediumArmorTrace_Execute)
+    };
+
+    CommandInfo kCommandInfo_StopMediumArmorTrace =
+    {
+        "StopMediumArmorTrace",
+        "",
+        kCmd_StopMediumArmorTrace,
+        "Stops the trace capture and writes it as Chrome trace-event JSON.",
+        0,
+        0,
+        nullptr,
+        HANDLER(Cmd_StopMediumArmorTrace_Execute)
+    };
+
+    CommandInfo kCommandInfo_SetMediumArmorHookEnabled =
+    {
+        "SetMediumArmorHookEnabled",
+        "SetMedHook",
+        kCmd_SetMediumArmorHookEnabled,
+        "Enables (1) or disables (0) a hook by index and lists their state; engine fixes cannot be toggled.",
+        0,
+        2,
+        kParams_TwoInts,
+        HANDLER(Cmd_SetMediumArmorHookEnabled_Execute)
+    };
+
+    CommandInfo kCommandInfo_SampleMediumArmorHook =
+    {
+        "SampleMediumArmorHook",
+        "SampleMedHook",
+        kCmd_SampleMediumArmorHook,
+        "Holds a hook on across sampling windows and logs its call rate and callout cost.",
+        0,
+        2,
+        kParams_OneIntOneOptionalInt,
+        HANDLER(Cmd_SampleMediumArmorHook_Execute)
+    };
+
+    CommandInfo kCommandInfo_GetMediumArmorARCacheStats =
+    {
+        "GetMediumArmorARCacheStats",
+        "",
+        kCmd_GetMediumArmorARCacheStats,
+        "Returns the inventory display AR cache hit percentage.",
+        0,
+        0,
+        nullptr,
+        HANDLER(Cmd_GetMediumArmorARCacheStats_Execute)
+    };
+
+    CommandInfo kCommandInfo_ListMediumArmor =
+    {
+        "ListMediumArmor",
+        "",
+        kCmd_ListMediumArmor,
+        "Returns an array of every medium-armour form, optionally only those from one mod index.",
+        0,
+        1,
+        kParams_OneOptionalInt,
+        HANDLER(Cmd_ListMediumArmor_Execute)
+    };
+
+    CommandInfo kCommandInfo_ListArmorByTier =
+    {
+        "ListArmorByTier",
+        "",
+        kCmd_ListArmorByTier,
+        "Returns an array of the armour forms in a tier (0 light, 1 medium, 2 heavy), optionally from one mod index.",
+        0,
+        2,
+        kParams_OneIntOneOptionalInt,
+        HANDLER(Cmd_ListArmorByTier_Execute)
+    };
+
+    CommandInfo kCommandInfo_GetMediumArmorWarmUpStats =
+    {
+        "GetMediumArmorWarmUpStats",
+        "",
+        kCmd_GetMediumArmorWarmUpStats,
+        "Returns the number of actors waiting for a wear warm-up scan; 1 resets the counters.",
+        0,
+        1,
+        kParams_OneOptionalInt,
+        HANDLER(Cmd_GetMediumArmorWarmUpStats_Execute)
+    };
+
+    CommandInfo kCommandInfo_GetMediumArmorChangesSince =
+    {
+        "GetMediumArmorChangesSince",
+        "",
+        kCmd_GetMediumArmorChangesSince,
+        "Returns what changed after the given epoch (skill, watched actors' medium counts) as a string map, or 0 if nothing did.",
+        0,
+        1,
+        kParams_OneInt,
+        HANDLER(Cmd_GetMediumArmorChangesSince_Execute)
+    };
+
+    CommandInfo kCommandInfo_CompareMediumArmorIndex =
+    {
+        "CompareMediumArmorIndex",
+        "",
+        kCmd_CompareMediumArmorIndex,
+        "Debug: times the per-form medium-armour loop against the tier index, best of N passes (default 10).",
+        0,
+        1,
+        kParams_OneOptionalInt,
+        HANDLER(Cmd_CompareMediumArmorIndex_Execute)
+    };
+
+    void RegisterCommands(const OBSEInterface* obse)
+    {
+        s_arrayInterface = static_cast<OBSEArrayVarInterface*>(obse->QueryInterface(kInterface_ArrayVar));
+
+        obse->SetOpcodeBase(kCmdBase);
+        obse->RegisterCommand(&kCommandInfo_GetMediumArmorSkill);
+        obse->RegisterCommand(&kCommandInfo_SetMediumArmorSkill);
+        obse->RegisterCommand(&kCommandInfo_ModMediumArmorSkill);
+        obse->RegisterCommand(&kCommandInfo_IsMediumArmor);
+        obse->RegisterCommand(&kCommandInfo_GetEquippedMediumCount);
+        obse->RegisterCommand(&kCommandInfo_IsWearingMediumArmor);
+        obse->RegisterCommand(&kCommandInfo_StartMediumArmorTrace);
+        obse->RegisterCommand(&kCommandInfo_StopMediumArmorTrace);
+        obse->RegisterCommand(&kCommandInfo_SetMediumArmorHookEnabled);
+        obse->RegisterCommand(&kCommandInfo_SampleMediumArmorHook);
+        obse->RegisterCommand(&kCommandInfo_GetMediumArmorARCacheStats);
+        obse->RegisterTypedCommand(&kCommandInfo_ListMediumArmor, kRetnType_Array);
+        obse->RegisterTypedCommand(&kCommandInfo_ListArmorByTier, kRetnType_Array);
+        obse->RegisterCommand(&kCommandInfo_GetMediumArmorWarmUpStats);
+        obse->RegisterTypedCommand(&kCommandInfo_GetMediumArmorChangesSince, kRetnType_Array);
+        obse->RegisterCommand(&kCommandInfo_CompareMediumArmorIndex);
+    }
+
 }
\ No newline at end of file
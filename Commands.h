@@ -21,6 +21,16 @@ namespace MediumArmor
         kCmd_IsMediumArmor = kCmdBase + 3,
         kCmd_GetEquippedMediumCount = kCmdBase + 4,
         kCmd_IsWearingMediumArmor = kCmdBase + 5,
+        kCmd_StartMediumArmorTrace = kCmdBase + 6,
+        kCmd_StopMediumArmorTrace = kCmdBase + 7,
+        kCmd_SetMediumArmorHookEnabled = kCmdBase + 8,
+        kCmd_SampleMediumArmorHook = kCmdBase + 9,
+        kCmd_GetMediumArmorARCacheStats = kCmdBase + 10,
+        kCmd_ListMediumArmor = kCmdBase + 11,
+        kCmd_ListArmorByTier = kCmdBase + 12,
+        kCmd_GetMediumArmorWarmUpStats = kCmdBase + 13,
+        kCmd_GetMediumArmorChangesSince = kCmdBase + 14,
+        kCmd_CompareMediumArmorIndex = kCmdBase + 15,
     };
 
     extern CommandInfo kCommandInfo_GetMediumArmorSkill;
@@ -29,5 +39,17 @@ namespace MediumArmor
     extern CommandInfo kCommandInfo_IsMediumArmor;
     extern CommandInfo kCommandInfo_GetEquippedMediumCount;
     extern CommandInfo kCommandInfo_IsWearingMediumArmor;
+    extern CommandInfo kCommandInfo_StartMediumArmorTrace;
+    extern CommandInfo kCommandInfo_StopMediumArmorTrace;
+    extern CommandInfo kCommandInfo_SetMediumArmorHookEnabled;
+    extern CommandInfo kCommandInfo_SampleMediumArmorHook;
+    extern CommandInfo kCommandInfo_GetMediumArmorARCacheStats;
+    extern CommandInfo kCommandInfo_ListMediumArmor;
+    extern CommandInfo kCommandInfo_ListArmorByTier;
+    extern CommandInfo kCommandInfo_GetMediumArmorWarmUpStats;
+    extern CommandInfo kCommandInfo_GetMediumArmorChangesSince;
+    extern CommandInfo kCommandInfo_CompareMediumArmorIndex;
+
+    void RegisterCommands(const OBSEInterface* obse);
 
 }  // namespace MediumArmor
\ No newline at end of file
@@ -1,9 +1,12 @@
 #pragma once
 // ============================================================================
 //  MediumArmor OBSE Plugin  Config.h
-//  Shared constants, version info, and tuning knobs.
+//  Shared constants, version info, and tuning knobs.  Standalone, so the
+//  portable sources that include it build without the OBSE prefix.
 // ============================================================================
 
+#include <cstdint>
+
 namespace MediumArmor
 {
 
@@ -15,4 +18,17 @@ namespace MediumArmor
 	constexpr float kXPPerHit = 1.0f;
 	constexpr float kXPSkillFactor = 0.5f;
 
+	constexpr uint32_t kFrameWindowMs = 16;
+	constexpr uint32_t kSampleWindowMs = 500;
+
+	// Frames without an inventory AR redraw before the display cache is dropped.
+	constexpr uint32_t kARDisplayCacheIdleFrames = 30;
+
+	constexpr const char* kSettingsPath = "Data\\OBSE\\Plugins\\MediumArmor.ini";
+
+	constexpr const char* kTraceOutputPath = "MediumArmorTrace.json";
+
+	constexpr const char* kClassCachePath = "Data\\OBSE\\Plugins\\MediumArmor.cache";
+	constexpr const char* kKeywordConfigDir = "Data\\OBSE\\Plugins\\OBSEKeywords";
+
 }
\ No newline at end of file
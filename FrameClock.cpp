@@ -0,0 +1,82 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - FrameClock.cpp
+// ============================================================================
+
+#include "FrameClock.h"
+#include "Config.h"
+#include "Timing.h"
+
+#include <windows.h>
+
+namespace MediumArmor::FrameClock
+{
+
+    static Listener s_listeners[kMaxListeners] = {};
+    static uint32_t s_listenerCount = 0;
+    static uint32_t s_frame = 0;
+    static bool     s_inTick = false;
+    static uint64_t s_lastWorkNs = 0;
+    static UINT_PTR s_timer = 0;
+
+    bool AddListener(Listener fn)
+    {
+        if (!fn || s_listenerCount == kMaxListeners)
+            return false;
+
+        s_listeners[s_listenerCount++] = fn;
+        return true;
+    }
+
+    uint32_t Current()
+    {
+        return s_frame;
+    }
+
+    static void Tick()
+    {
+        const uint64_t now = Timing::NowNs();
+        const uint32_t frame = static_cast<uint32_t>(now / (kFrameWindowMs * 1000000ull));
+        if (frame == s_frame || s_inTick)
+            return;
+
+        // A listener that pumps messages (a modal box) would re-enter.
+        s_frame = frame;
+        s_inTick = true;
+        for (uint32_t i = 0; i < s_listenerCount; ++i)
+            s_listeners[i](frame);
+        s_inTick = false;
+
+        s_lastWorkNs = Timing::NowNs() - now;
+    }
+
+    static void CALLBACK OnTimer(HWND, UINT, UINT_PTR, DWORD)
+    {
+        Tick();
+    }
+
+    bool Start()
+    {
+        if (s_timer)
+            return true;
+
+        // No window: the timer belongs to this thread's queue.
+        s_timer = SetTimer(nullptr, 0, kFrameWindowMs, &OnTimer);
+        if (!s_timer)
+        {
+            _ERROR("MediumArmor: could not start the frame timer (error %u); per-frame work is off.", GetLastError());
+            return false;
+        }
+        return true;
+    }
+
+    bool IsRunning()
+    {
+        return s_timer != 0;
+    }
+
+    uint64_t LastWorkNs()
+    {
+        return s_lastWorkNs;
+    }
+
+}
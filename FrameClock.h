@@ -0,0 +1,35 @@
+#pragma once
+// ============================================================================
+//  MediumArmor OBSE Plugin - FrameClock.h
+//
+//  The plugin has no main-loop hook, so "frames" are fixed wall-clock slots
+//  of kFrameWindowMs, driven by a thread timer on the game's main thread.
+//  The game pumps its message queue between frames; the timer's WM_TIMER
+//  is dispatched there, outside any engine function, and runs Tick().  The
+//  first Tick() in a new slot runs the registered per-frame listeners.
+//
+//  Listeners may do real work (scans, console lines, shared-memory
+//  publishes), so nothing else calls Tick(): never from a detour or a
+//  callout reachable from one.  Current() is a plain read and safe anywhere.
+// ============================================================================
+
+#include <cstdint>
+
+namespace MediumArmor::FrameClock
+{
+	typedef void (*Listener)(uint32_t frame);
+
+	constexpr uint32_t kMaxListeners = 8;
+
+	bool     AddListener(Listener fn);
+
+	// Installs the driver.  Must be called on the main thread.
+	bool     Start();
+	bool     IsRunning();
+
+	// Frame index of the last Tick().
+	uint32_t Current();
+
+	// Time the listeners took in the last new-frame Tick().
+	uint64_t LastWorkNs();
+}
@@ -0,0 +1,181 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - HookControl.cpp
+// ============================================================================
+
+#include "HookControl.h"
+#include "Config.h"
+#include "Timing.h"
+#include "FrameClock.h"
+
+#include "obse/GameAPI.h"
+
+volatile UInt8  g_hookEnabled[MediumArmor::HookControl::kHook_Count] = { 1, 1, 1, 1, 1, 1 };
+volatile UInt32 g_hookCalls[MediumArmor::HookControl::kHook_Count] = {};
+
+namespace MediumArmor::HookControl
+{
+
+    static const char* kHookNames[kHook_Count] =
+    {
+        "Hook1_Sub488CB0",
+        "Hook2_IsHeavyArmor",
+        "Hook3_GetArmorSkillAV",
+        "Hook4_CalcArmorRating",
+        "Patch_ApplyTrapDamage",
+        "Patch_GetDamage",
+    };
+
+    // ── Sampling state ─────────────────────────────────────────────────────
+    struct SampleTotals
+    {
+        UInt32 windows;
+        UInt64 elapsedNs;
+        UInt64 calls;
+        UInt64 calloutNs;
+        double peakMsPerSec;    // busiest single window
+    };
+
+    static bool         s_sampling = false;
+    static bool         s_listening = false;
+    static UInt32       s_sampleHook = 0;
+    static UInt32       s_sampleWindowsLeft = 0;
+    static bool         s_sampleOriginalState = true;
+    static UInt64       s_windowStartNs = 0;
+    static UInt32       s_windowStartCalls = 0;
+    static UInt64       s_windowStartCalloutNs = 0;
+    static SampleTotals s_totals = {};
+
+    static UInt64       s_calloutNs[kHook_Count] = {};
+
+    static void OnFrame(uint32_t frame);
+
+    const char* GetName(UInt32 id)
+    {
+        return id < kHook_Count ? kHookNames[id] : "<invalid>";
+    }
+
+    bool IsToggleable(UInt32 id)
+    {
+        return id < kPatch_ApplyTrapDamage;
+    }
+
+    bool IsEnabled(UInt32 id)
+    {
+        return id < kHook_Count && g_hookEnabled[id] != 0;
+    }
+
+    bool SetEnabled(UInt32 id, bool enabled)
+    {
+        if (!IsToggleable(id) || (s_sampling && id == s_sampleHook))
+            return false;
+
+        g_hookEnabled[id] = enabled ? 1 : 0;
+        _MESSAGE("MediumArmor: %s %s.", kHookNames[id], enabled ? "enabled" : "disabled");
+        return true;
+    }
+
+    UInt32 GetCallCount(UInt32 id)
+    {
+        return id < kHook_Count ? g_hookCalls[id] : 0;
+    }
+
+    UInt64 GetCalloutNs(UInt32 id)
+    {
+        return id < kHook_Count ? s_calloutNs[id] : 0;
+    }
+
+    static void BeginWindow(UInt64 now)
+    {
+        s_windowStartNs = now;
+        s_windowStartCalls = g_hookCalls[s_sampleHook];
+        s_windowStartCalloutNs = s_calloutNs[s_sampleHook];
+    }
+
+    bool StartSampling(UInt32 id, UInt32 windows)
+    {
+        if (!IsToggleable(id) || s_sampling || windows == 0)
+            return false;
+
+        s_sampleHook = id;
+        s_sampleWindowsLeft = windows;
+        s_sampleOriginalState = g_hookEnabled[id] != 0;
+        s_totals = {};
+
+        if (!s_listening)
+            s_listening = FrameClock::AddListener(&OnFrame);
+        if (!s_listening)
+            return false;
+
+        g_hookEnabled[id] = 1;
+        BeginWindow(Timing::NowNs());
+        s_sampling = true;
+
+        _MESSAGE("MediumArmor: Sampling %s over %u windows of %u ms.",
+            kHookNames[id], windows, kSampleWindowMs);
+        return true;
+    }
+
+    bool IsSampling()
+    {
+        return s_sampling;
+    }
+
+    static void ReportSampling()
+    {
+        const char* name = kHookNames[s_sampleHook];
+        const SampleTotals& t = s_totals;
+        const double seconds = t.elapsedNs / 1e9;
+        const double callsPerSec = seconds > 0.0 ? t.calls / seconds : 0.0;
+        const double nsPerCall = t.calls ? static_cast<double>(t.calloutNs) / t.calls : 0.0;
+        const double msPerSec = seconds > 0.0 ? (t.calloutNs / 1e6) / seconds : 0.0;
+
+        _MESSAGE("MediumArmor: Sample for %s: windows=%u  calls/s=%.0f  callout ns/call=%.1f  "
+            "callout ms/s=%.3f (peak window %.3f)",
+            name, t.windows, callsPerSec, nsPerCall, msPerSec, t.peakMsPerSec);
+        Console_Print("%s: %.0f calls/s, %.1f ns/call, %.3f ms/s (peak %.3f)",
+            name, callsPerSec, nsPerCall, msPerSec, t.peakMsPerSec);
+    }
+
+    static void OnFrame(uint32_t)
+    {
+        if (!s_sampling)
+            return;
+
+        const UInt64 now = Timing::NowNs();
+        if (now - s_windowStartNs < kSampleWindowMs * 1000000ull)
+            return;
+
+        const UInt64 elapsedNs = now - s_windowStartNs;
+        const UInt64 windowCalloutNs = s_calloutNs[s_sampleHook] - s_windowStartCalloutNs;
+        const double windowMsPerSec = (windowCalloutNs / 1e6) / (elapsedNs / 1e9);
+
+        SampleTotals& t = s_totals;
+        ++t.windows;
+        t.elapsedNs += elapsedNs;
+        t.calls += g_hookCalls[s_sampleHook] - s_windowStartCalls;
+        t.calloutNs += windowCalloutNs;
+        if (windowMsPerSec > t.peakMsPerSec)
+            t.peakMsPerSec = windowMsPerSec;
+
+        if (--s_sampleWindowsLeft == 0)
+        {
+            s_sampling = false;
+            g_hookEnabled[s_sampleHook] = s_sampleOriginalState ? 1 : 0;
+            ReportSampling();
+            return;
+        }
+
+        BeginWindow(now);
+    }
+
+    CostScope::CostScope(UInt32 id) : m_id(id), m_start(Timing::NowNs())
+    {
+    }
+
+    CostScope::~CostScope()
+    {
+        if (m_id < kHook_Count)
+            s_calloutNs[m_id] += Timing::NowNs() - m_start;
+    }
+
+}
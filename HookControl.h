@@ -0,0 +1,72 @@
+#pragma once
+// ============================================================================
+//  MediumArmor OBSE Plugin - HookControl.h
+//
+//  Live enable bits and call counters for every detour and engine patch.
+//  Each naked stub bumps its counter on entry; the MediumArmor detours
+//  also test their enable byte, and a cleared byte sends them straight
+//  down the original code path.
+//
+//  The GPEngineFixes crash fixes (kPatch_*) have no live switch: turning
+//  one off would bring its crash back, so they are only ever installed or
+//  removed whole with the manifest.  SetEnabled and sampling refuse them.
+//
+//  Sampling holds one hook on for a number of fixed wall-clock windows (the
+//  plugin has no main-loop hook; windows advance from FrameClock) and
+//  reports its call rate and the time spent in its C++ callouts.  Only the
+//  callout is timed, so there is no "off" figure to compare against: with
+//  the hook off the callout does not run at all.
+// ============================================================================
+
+// ── ASM-visible, indexed by MediumArmor::HookControl::HookId ───────────────
+extern volatile UInt8  g_hookEnabled[];
+extern volatile UInt32 g_hookCalls[];
+
+namespace MediumArmor::HookControl
+{
+	// Keep in sync with the literal indices used by the asm stubs.
+	enum HookId : UInt32
+	{
+		kHook_Sub488CB0 = 0,
+		kHook_IsHeavyArmor = 1,
+		kHook_GetArmorSkillAV = 2,
+		kHook_CalcArmorRating = 3,
+		kPatch_ApplyTrapDamage = 4,
+		kPatch_GetDamage = 5,
+
+		kHook_Count
+	};
+
+	const char* GetName(UInt32 id);
+
+	// A detour with an enable byte; false for the crash fixes.
+	bool  IsToggleable(UInt32 id);
+
+	bool  IsEnabled(UInt32 id);
+	bool  SetEnabled(UInt32 id, bool enabled);
+
+	UInt32 GetCallCount(UInt32 id);
+
+	// Running total of time spent in `id`'s C++ callouts since load.
+	UInt64 GetCalloutNs(UInt32 id);
+
+	bool  StartSampling(UInt32 id, UInt32 windows);
+	bool  IsSampling();
+
+	// Adds the time spent in a hook's C++ callout to its running total.
+	// Always on: two clock reads per callout, so the metrics page can
+	// publish per-frame callout time whether or not a sample is running.
+	class CostScope
+	{
+	public:
+		explicit CostScope(UInt32 id);
+		~CostScope();
+
+		CostScope(const CostScope&) = delete;
+		CostScope& operator=(const CostScope&) = delete;
+
+	private:
+		UInt32 m_id;
+		UInt64 m_start;
+	};
+}
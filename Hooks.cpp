@@ -10,14 +10,15 @@
 //      Returns false for medium armor so engine classifies it as non-heavy.
 //
 //  Hook 3 — GetArmorSkillAV (flag setter)
-//      Sets a thread-local flag + caches medium skill value when a medium
-//      piece is queried.  Still returns a valid AV code so the caller's
-//      GetActorValue doesn't crash.
+//      Sets a flag and remembers the form when a medium piece is queried.
+//      Still returns a valid AV code so the caller's GetActorValue doesn't
+//      crash.
 //
 //  Hook 4 — Calc_ArmorRating (flag consumer)
-//      Checks the flag.  If set, replaces the skill parameter on the stack
-//      with the cached medium skill, clears the flag, then runs the original.
-//      This fixes the inventory display AR and any other code path that does
+//      Checks the flag.  If set, clears it and answers from the display AR
+//      cache by (form, condition); a miss runs the original with the medium
+//      skill in place of the one passed.  This fixes the inventory display
+//      AR and any other code path that does
 //      GetArmorSkillAV → GetActorValue → Calc_ArmorRating.
 //
 //  All addresses: Oblivion 1.2.0.416 (GOTY / Steam).
@@ -26,6 +27,10 @@
 #include "Hooks.h"
 #include "MediumArmor.h"
 #include "Config.h"
+#include "Trace.h"
+#include "HookControl.h"
+#include "ARCache.h"
+#include "PatchManifest.h"
 
 #include "obse/GameAPI.h"
 #include "obse/GameObjects.h"
@@ -74,8 +79,7 @@ namespace MediumArmor
     constexpr UInt32 kStolenBytes_488CB0 = 9;   // sub esp,0Ch + fld [...]
     constexpr UInt32 kStolenBytes_IsHeavyArmor = 7;   // mov al,[ecx+6Ah] + shr al,7 + retn
     constexpr UInt32 kStolenBytes_SkillAV = 16;  // entire function (0x10 bytes)
-    // Calc_ArmorRating stolen bytes — set after prologue dump
-    static UInt32    s_stolenBytes_CalcAR = 0;
+    constexpr UInt32 kStolenBytes_CalcAR = 9;   // fld [esp+0Ch] + call rel32
 
     // ════════════════════════════════════════════════════════════════════════════
     //  Vanilla function pointer types
@@ -86,7 +90,7 @@ namespace MediumArmor
     typedef float(__thiscall* GetHealth_t)(void*, int);
 
     // ════════════════════════════════════════════════════════════════════════════
-    //  Resolved vanilla function pointers  (set in InstallHooks)
+    //  Resolved vanilla function pointers  (set by ResolveCombatPointers)
     // ════════════════════════════════════════════════════════════════════════════
 
     static Calc_ArmorRating_t fn_CalcArmorRating = nullptr;
@@ -97,11 +101,7 @@ namespace MediumArmor
     //  State
     // ════════════════════════════════════════════════════════════════════════════
 
-    static UInt8 s_origBytes_488CB0[kStolenBytes_488CB0];
-    static UInt8 s_origBytes_IHA[kStolenBytes_IsHeavyArmor];
-    static UInt8 s_origBytes_SkillAV[kStolenBytes_SkillAV];
-    static UInt8 s_origBytes_CalcAR[16];  // max we'd ever steal
-    static bool  s_hookInstalled = false;
+    static bool s_hooksRegistered = false;
 
     // ════════════════════════════════════════════════════════════════════════════
     //  Helpers
@@ -119,6 +119,9 @@ namespace MediumArmor
 
     static float __cdecl CalcMediumPieceAR(int equippedInstance, void* actor)
     {
+        MA_TRACE_SCOPE("CalcMediumPieceAR");
+        HookControl::CostScope cost(HookControl::kHook_Sub488CB0);
+
         void* armorForm = *(void**)(equippedInstance + 0x8);
         if (!armorForm)
             return 0.0f;
@@ -129,9 +132,6 @@ namespace MediumArmor
 
         float luck = fnGetAV(actor, 7);
 
-        float skill = GetMediumArmorSkill() * kARMultiplier + kARFlat;
-        skill = std::clamp(skill, 0.0f, 100.0f);
-
         float condition = 0.0f;
         int maxHP = fn_GetHealthForForm(armorForm);
         if (maxHP != 0)
@@ -142,14 +142,13 @@ namespace MediumArmor
             condition = fn_GetHealth(reinterpret_cast<void*>(equippedInstance), 0) / maxHPf;
         }
 
+        float skill = GetEffectiveMediumArmorSkill();
+
         UInt16 rawAR = *(UInt16*)((UInt8*)armorForm + 0xE4);
         UInt16 baseAR = static_cast<UInt16>(static_cast<double>(rawAR) / 100.0);
 
         double result = fn_CalcArmorRating(baseAR, skill, luck, condition);
 
-        _MESSAGE("MediumArmor AR (combat): baseAR=%u skill=%.1f luck=%.1f cond=%.3f -> %.1f",
-            baseAR, skill, luck, condition, result);
-
         float fresult = static_cast<float>(result);
         float truncated = static_cast<float>(static_cast<int>(fresult));
         if (truncated - fresult < 0.0f)
@@ -164,43 +163,64 @@ namespace MediumArmor
 
 }  // close MediumArmor namespace temporarily
 
+// ── Classification callouts — one per detour so trace spans name the hook.
+//    The spans cover the callout only; the naked detour around it (call
+//    counter, enable test, register saves) is not in them.
+static bool __cdecl IsMediumArmor_Sub488CB0(TESForm* form)
+{
+    MA_TRACE_SCOPE("Sub488CB0_Classify");
+    MediumArmor::HookControl::CostScope cost(MediumArmor::HookControl::kHook_Sub488CB0);
+    return MediumArmor::IsMediumArmor(form);
+}
+
+static bool __cdecl IsMediumArmor_IsHeavyArmor(TESForm* form)
+{
+    MA_TRACE_SCOPE("IsHeavyArmor_Classify");
+    MediumArmor::HookControl::CostScope cost(MediumArmor::HookControl::kHook_IsHeavyArmor);
+    return MediumArmor::IsMediumArmor(form);
+}
+
+static bool __cdecl IsMediumArmor_GetArmorSkillAV(TESForm* form)
+{
+    MA_TRACE_SCOPE("GetArmorSkillAV_Classify");
+    MediumArmor::HookControl::CostScope cost(MediumArmor::HookControl::kHook_GetArmorSkillAV);
+    return MediumArmor::IsMediumArmor(form);
+}
+
 // ── ASM-callable function pointers ─────────────────────────────────────────
-static bool(__cdecl* s_fnIsMediumArmor)(TESForm*) = nullptr;
+static bool(__cdecl* s_fnIsMediumArmor_Sub488CB0)(TESForm*) = nullptr;
+static bool(__cdecl* s_fnIsMediumArmor_IsHeavyArmor)(TESForm*) = nullptr;
+static bool(__cdecl* s_fnIsMediumArmor_GetArmorSkillAV)(TESForm*) = nullptr;
 static float(__cdecl* s_fnCalcMediumPieceAR)(int, void*) = nullptr;
 static UInt32 s_resumeAddr_488CB0 = 0;
 static UInt32 s_resumeAddr_CalcAR = 0;
 
-// ── Medium armor flag (set by Hook 3, consumed by Hook 4) ──────────────────
-static bool  s_mediumArmorFlag = false;
-static float s_mediumSkillValue = 0.0f;
-
-// ── Helper: get medium skill with modifiers applied ────────────────────────
-static float __cdecl GetMediumSkillWithMods()
-{
-    float skill = MediumArmor::GetMediumArmorSkill()
-        * MediumArmor::kARMultiplier
-        + MediumArmor::kARFlat;
-    return std::clamp(skill, 0.0f, 100.0f);
-}
-static float(__cdecl* s_fnGetMediumSkill)() = &GetMediumSkillWithMods;
+// ── Medium armor flag and form (set by Hook 3, consumed by Hook 4) ─────────
+static bool     s_mediumArmorFlag = false;
+static TESForm* s_mediumArmorForm = nullptr;
 
 // ════════════════════════════════════════════════════════════════════════════
 //  Hook 2 — IsHeavyArmor detour  (0x004B4C70)
-//  Medium → return false.  Otherwise → original logic.
+//  Medium → return false.  Otherwise (or disabled) → original logic.
 // ════════════════════════════════════════════════════════════════════════════
 
 static __declspec(naked) void Detour_IsHeavyArmor()
 {
     __asm
     {
+        inc     dword ptr[g_hookCalls + 4 * 1]  // kHook_IsHeavyArmor
+        cmp     byte ptr[g_hookEnabled + 1], 0
+        jz      not_medium
+
         push    ecx
         push    ecx
-        call[s_fnIsMediumArmor]
+        call[s_fnIsMediumArmor_IsHeavyArmor]
         add     esp, 4
         test    al, al
         pop     ecx
         jnz     is_medium
 
+        not_medium :
         mov     al, [ecx + 0x6A]
         shr     al, 7
         ret
@@ -213,24 +233,29 @@ static __declspec(naked) void Detour_IsHeavyArmor()
 
 // ════════════════════════════════════════════════════════════════════════════
 //  Hook 3 — GetArmorSkillAV detour  (0x004B4C80)
-//  Medium → set flag + cache skill, return kActorVal_LightArmor (0x1B).
-//  Otherwise → original branchless logic.
+//  Medium → set flag + remember form, return kActorVal_LightArmor (0x1B).
+//  Otherwise (or disabled) → original branchless logic.
 // ════════════════════════════════════════════════════════════════════════════
 
 static __declspec(naked) void Detour_GetArmorSkillAV()
 {
     __asm
     {
+        inc     dword ptr[g_hookCalls + 4 * 2]  // kHook_GetArmorSkillAV
+        cmp     byte ptr[g_hookEnabled + 2], 0
+        jz      not_medium
+
         // ECX = TESObjectARMO* (thiscall)
         push    ecx
         push    ecx                             // arg: TESForm*
-        call[s_fnIsMediumArmor]             // bool __cdecl
+        call[s_fnIsMediumArmor_GetArmorSkillAV] // bool __cdecl
         add     esp, 4
         test    al, al
         pop     ecx
         jnz     medium_skill
 
         // ── Not medium: original logic ─────────────────────────────────────
+        not_medium :
         mov     al, [ecx + 0x6A]
         and al, 0x80
         neg     al
@@ -239,34 +264,47 @@ static __declspec(naked) void Detour_GetArmorSkillAV()
         add     eax, 1Bh
         ret
 
-        // ── Medium: set flag + cache skill, return light AV code ───────────
+        // ── Medium: set flag + remember form, return light AV code ─────────
+        //    The skill is read in Hook 4, and only on a display cache miss.
         medium_skill :
         mov     byte ptr[s_mediumArmorFlag], 1
-
-            // Cache the skill value including our multiplier/flat modifiers.
-            // We can't easily call C++ from naked ASM, so we store a pre-computed
-            // value that InstallHooks updates.  But GetMediumArmorSkill() can
-            // change at any time (SetMediumArmorSkill console cmd), so we need
-            // to read it live.  Use a minimal inline approach:
-            push    ecx
-            push    edx
-            call[s_fnGetMediumSkill]            // float __cdecl → ST(0)
-            fstp    dword ptr[s_mediumSkillValue]  // store to static
-            pop     edx
-            pop     ecx
-
+            mov     dword ptr[s_mediumArmorForm], ecx
             mov     eax, 1Bh                        // return kActorVal_LightArmor
             ret
     }
 }
 
+// ── Hook 4 medium path: Calc_ArmorRating through the display AR cache ─────
+//    Same cdecl signature as the original, so the detour tail-jumps here.
+//    A hit needs neither the skill nor the formula; a miss runs the
+//    original with the medium skill through the trampoline built in
+//    BuildCalcARTrampoline.  The caller's skill argument is the light armor
+//    skill Hook 3 pointed it at, and is ignored.
+static double __cdecl CachedCalcArmorRating(unsigned short baseAR, float, float luck, float condition)
+{
+    MA_TRACE_SCOPE("CalcArmorRating_Medium");
+    MediumArmor::HookControl::CostScope cost(MediumArmor::HookControl::kHook_CalcArmorRating);
+
+    double value = 0.0;
+    if (MediumArmor::ARCache::LookupDisplay(s_mediumArmorForm, baseAR, luck, condition, value))
+        return value;
+
+    auto original = reinterpret_cast<MediumArmor::Calc_ArmorRating_t>(s_resumeAddr_CalcAR);
+    value = original(baseAR, MediumArmor::GetEffectiveMediumArmorSkill(), luck, condition);
+    MediumArmor::ARCache::StoreDisplay(s_mediumArmorForm, baseAR, luck, condition, value);
+    return value;
+}
+static double(__cdecl* s_fnCachedCalcAR)(unsigned short, float, float, float) = &CachedCalcArmorRating;
+
 // ════════════════════════════════════════════════════════════════════════════
 //  Hook 4 — Calc_ArmorRating detour  (0x00547370)
-//  If flag set: replace skill param on stack, clear flag, fall through.
+//  If flag set: clear flag, then tail-jump to CachedCalcArmorRating with
+//  the arguments untouched.  Otherwise fall through to the original.
+//  Disabled: drop any pending flag and run the original untouched.
 //  Stack layout at entry (cdecl):
 //      [ESP+0]  = return address
 //      [ESP+4]  = a1: baseAR  (uint16)
-//      [ESP+8]  = a2: skill   (float)  ← we replace this
+//      [ESP+8]  = a2: skill   (float)  ← medium path ignores this
 //      [ESP+C]  = a3: luck    (float)
 //      [ESP+10] = a4: condition (float)
 // ════════════════════════════════════════════════════════════════════════════
@@ -275,21 +313,25 @@ static __declspec(naked) void Detour_CalcArmorRating()
 {
     __asm
     {
+        inc     dword ptr[g_hookCalls + 4 * 3]  // kHook_CalcArmorRating
+        cmp     byte ptr[g_hookEnabled + 3], 0
+        jz      disabled
+
         cmp     byte ptr[s_mediumArmorFlag], 0
-        jz      no_swap
+        jz      vanilla
 
-        // ── Medium: swap skill param and clear flag ────────────────────────
+        // ── Medium: clear flag, cached path swaps the skill on a miss ──────
         mov     byte ptr[s_mediumArmorFlag], 0
-        push    eax
-        mov     eax, dword ptr[s_mediumSkillValue]
-        mov[esp + 0x0C], eax               // [esp+8+4] because we pushed eax
-        pop     eax
+        jmp[s_fnCachedCalcAR]                  // returns straight to our caller
 
-        no_swap :
+        disabled :
+        mov     byte ptr[s_mediumArmorFlag], 0
+
+        vanilla :
         // ── Execute stolen prologue bytes, then jump to resume ─────────────
         //    Filled at install time by copying the first N bytes.
         //    PLACEHOLDER: we use push/ret to jump to a C++ trampoline
-        //    that replays the stolen bytes.  See InstallHooks().
+        //    that replays the stolen bytes.  See BuildCalcARTrampoline().
         jmp[s_resumeAddr_CalcAR]
     }
 }
@@ -302,10 +344,14 @@ static __declspec(naked) void Detour_Sub488CB0()
 {
     __asm
     {
+        inc     dword ptr[g_hookCalls + 4 * 0]  // kHook_Sub488CB0
+        cmp     byte ptr[g_hookEnabled + 0], 0
+        jz      vanilla_path
+
         push    ecx
         mov     eax, [ecx + 0x8]
         push    eax
-        call[s_fnIsMediumArmor]
+        call[s_fnIsMediumArmor_Sub488CB0]
         add     esp, 4
         test    al, al
         pop     ecx
@@ -333,17 +379,109 @@ namespace MediumArmor
 {
 
     // ════════════════════════════════════════════════════════════════════════════
-    //  Public API
+    //  Hook plan — which hooks the loaded data can actually reach
+    //
+    //  Hook 1 and the Hook 3/4 pair matter whenever any medium form exists.
+    //  Hook 2 only changes the answer for medium forms that carry the heavy
+    //  flag (byte +0x6A bit 7); for the rest vanilla already returns false.
     // ════════════════════════════════════════════════════════════════════════════
 
-    bool InstallHooks()
+    struct HookPlan
     {
-        // ── Init ASM-callable pointers ─────────────────────────────────────────
-        s_fnIsMediumArmor = &IsMediumArmor;
-        s_fnCalcMediumPieceAR = &CalcMediumPieceAR;
-        s_resumeAddr_488CB0 = Addr::Sub_488CB0_Resume;
+        bool   combat;       // Hook 1
+        bool   heavyFlag;    // Hook 2
+        bool   display;      // Hooks 3 + 4
+        UInt32 mediumForms;
+        UInt32 heavyFlaggedForms;
+    };
+
+    static UInt32 CountHeavyFlaggedMediumForms()
+    {
+        const MediumArmorClassTable* table = GetClassTable();
+        UInt32 count = 0;
+        for (UInt32 i = 0; i < table->count; ++i)
+        {
+            TESForm* form = LookupFormByID(table->formIDs[i]);
+            if (form && HasHeavyFlag(form))
+                ++count;
+        }
+        return count;
+    }
 
-        // ── Resolve vanilla function pointers ──────────────────────────────────
+    static HookPlan BuildHookPlan()
+    {
+        // Classification not available yet — assume everything is reachable.
+        if (!IsClassificationTableBuilt())
+            return { true, true, true, 0, 0 };
+
+        HookPlan plan = {};
+        plan.mediumForms = GetClassTable()->count;
+        plan.heavyFlaggedForms = plan.mediumForms ? CountHeavyFlaggedMediumForms() : 0;
+        plan.combat = plan.mediumForms > 0;
+        plan.heavyFlag = plan.heavyFlaggedForms > 0;
+        plan.display = plan.mediumForms > 0;
+        return plan;
+    }
+
+    static void LogHookPlan(const HookPlan& plan)
+    {
+        // Every hooked engine call pays one IsMediumArmor callout; that is
+        // what a skipped hook saves per call.
+        const double calloutNs = MeasureIsMediumArmorNs(256);
+
+        _MESSAGE("MediumArmor: Hook plan: %u medium forms, %u heavy-flagged.",
+            plan.mediumForms, plan.heavyFlaggedForms);
+        _MESSAGE("  Hook 1 (sub_488CB0)        : %s", plan.combat ? "install" : "skip");
+        _MESSAGE("  Hook 2 (IsHeavyArmor)      : %s", plan.heavyFlag ? "install" : "skip");
+        _MESSAGE("  Hooks 3+4 (inventory AR)   : %s", plan.display ? "install" : "skip");
+
+        if (!plan.combat)
+            _MESSAGE("  Avoided on sub_488CB0      : ~%.0f ns per equipped piece evaluated", calloutNs);
+        if (!plan.heavyFlag)
+            _MESSAGE("  Avoided on IsHeavyArmor    : ~%.0f ns per call", calloutNs);
+        if (!plan.display)
+            _MESSAGE("  Avoided on GetArmorSkillAV : ~%.0f ns per call (+ Calc_ArmorRating flag check)", calloutNs);
+    }
+
+
+    // ════════════════════════════════════════════════════════════════════════════
+    //  Manifest entries
+    // ════════════════════════════════════════════════════════════════════════════
+
+    static const UInt8 kExpected_488CB0[] = {
+        0x83, 0xEC, 0x0C,
+        0xD9, 0x05, 0x34, 0x06, 0xA3, 0x00
+    };
+
+    static const UInt8 kExpected_IsHeavyArmor[] = {
+        0x8A, 0x41, 0x6A,
+        0xC0, 0xE8, 0x07,
+        0xC3
+    };
+
+    static const UInt8 kExpected_SkillAV[] = {
+        0x8A, 0x41, 0x6A,
+        0x24, 0x80,
+        0xF6, 0xD8,
+        0x1B, 0xC0,
+        0x83, 0xE0, 0xF7,
+        0x83, 0xC0, 0x1B,
+        0xC3
+    };
+
+    //  Calc_ArmorRating prologue (Oblivion 1.2.0.416):
+    //    00547370: D9 44 24 0C        fld dword ptr [esp+0Ch]   ; 4 bytes
+    //    00547374: E8 47 B5 43 00     call Calc_LuckModifiedSkill ; 5 bytes
+    //    00547379: ...                ← resume here
+    //  Only the call opcode is checked; its rel32 is fixed up in the trampoline.
+    static const UInt8 kExpected_CalcAR[] = {
+        0xD9, 0x44, 0x24, 0x0C,
+        0xE8
+    };
+
+    // Hook 1 prepare: read the call targets only once the prologue checked out.
+    static bool ResolveCombatPointers()
+    {
         fn_CalcArmorRating = reinterpret_cast<Calc_ArmorRating_t>(Addr::Calc_ArmorRating);
         fn_GetHealthForForm = reinterpret_cast<GetHealthForForm_t>(
             ExtractCallTarget(Addr::CallSite_GetHealthForForm));
@@ -354,196 +492,114 @@ namespace MediumArmor
         _MESSAGE("  Calc_ArmorRating  = %08X", Addr::Calc_ArmorRating);
         _MESSAGE("  GetHealthForForm  = %08X", reinterpret_cast<UInt32>(fn_GetHealthForForm));
         _MESSAGE("  GetHealth         = %08X", reinterpret_cast<UInt32>(fn_GetHealth));
+        return true;
+    }
 
-        // ════════════════════════════════════════════════════════════════════════
-        //  Hook 1: sub_488CB0  (combat AR)
-        // ════════════════════════════════════════════════════════════════════════
-        {
-            const UInt8 expected[] = {
-                0x83, 0xEC, 0x0C,
-                0xD9, 0x05, 0x34, 0x06, 0xA3, 0x00
-            };
-            if (memcmp(reinterpret_cast<void*>(Addr::Sub_488CB0),
-                expected, kStolenBytes_488CB0) != 0)
-            {
-                _ERROR("MediumArmor: sub_488CB0 prologue mismatch. Aborting.");
-                return false;
-            }
-            memcpy(s_origBytes_488CB0, reinterpret_cast<void*>(Addr::Sub_488CB0),
-                kStolenBytes_488CB0);
-            WriteRelJump(Addr::Sub_488CB0, reinterpret_cast<UInt32>(&Detour_Sub488CB0));
-            for (UInt32 i = 5; i < kStolenBytes_488CB0; ++i)
-                SafeWrite8(Addr::Sub_488CB0 + i, 0x90);
-            _MESSAGE("MediumArmor: Hook 1 (sub_488CB0) installed.");
-        }
+    // Hook 4 prepare: the stolen call is relative, so it is re-targeted.
+    //    [0..3]  fld dword ptr [esp+0Ch]    (copied verbatim)
+    //    [4..8]  call <fixed-up rel32>      (recalculated for trampoline addr)
+    //    [9..13] jmp Calc_ArmorRating+9     (resume original body)
+    static bool BuildCalcARTrampoline()
+    {
+        const UInt8* p = reinterpret_cast<const UInt8*>(Addr::Calc_ArmorRating);
 
-        // ════════════════════════════════════════════════════════════════════════
-        //  Hook 2: IsHeavyArmor
-        // ════════════════════════════════════════════════════════════════════════
-        {
-            const UInt8 expected[] = {
-                0x8A, 0x41, 0x6A,
-                0xC0, 0xE8, 0x07,
-                0xC3
-            };
-            if (memcmp(reinterpret_cast<void*>(Addr::IsHeavyArmor),
-                expected, kStolenBytes_IsHeavyArmor) != 0)
-            {
-                _ERROR("MediumArmor: IsHeavyArmor mismatch — skipping.");
-            }
-            else
-            {
-                memcpy(s_origBytes_IHA, reinterpret_cast<void*>(Addr::IsHeavyArmor),
-                    kStolenBytes_IsHeavyArmor);
-                WriteRelJump(Addr::IsHeavyArmor, reinterpret_cast<UInt32>(&Detour_IsHeavyArmor));
-                SafeWrite8(Addr::IsHeavyArmor + 5, 0x90);
-                SafeWrite8(Addr::IsHeavyArmor + 6, 0x90);
-                _MESSAGE("MediumArmor: Hook 2 (IsHeavyArmor) installed.");
-            }
-        }
+        UInt32 callSite = Addr::Calc_ArmorRating + 4;
+        SInt32 origRelOffset = *(SInt32*)(callSite + 1);
+        UInt32 callTarget = callSite + 5 + origRelOffset;  // Calc_LuckModifiedSkill
 
-        // ════════════════════════════════════════════════════════════════════════
-        //  Hook 4: Calc_ArmorRating  (install BEFORE hook 3 — hook 3 depends on it)
-        //
-        //  Prologue (Oblivion 1.2.0.416):
-        //    00547370: D9 44 24 0C        fld dword ptr [esp+0Ch]   ; 4 bytes
-        //    00547374: E8 47 B5 43 00     call Calc_LuckModifiedSkill ; 5 bytes
-        //    00547379: ...                ← resume here
-        //
-        //  We steal 9 bytes.  The trampoline must fix up the relative call.
-        // ════════════════════════════════════════════════════════════════════════
-        bool hook4_ok = false;
+        UInt8* tramp = static_cast<UInt8*>(
+            VirtualAlloc(nullptr, kStolenBytes_CalcAR + 5, MEM_COMMIT | MEM_RESERVE,
+                PAGE_EXECUTE_READWRITE));
+        if (!tramp)
         {
-            UInt8* p = reinterpret_cast<UInt8*>(Addr::Calc_ArmorRating);
-
-            // Verify the expected prologue
-            const UInt8 expectedPrologue[] = {
-                0xD9, 0x44, 0x24, 0x0C,                 // fld dword ptr [esp+0Ch]
-                0xE8                                     // call rel32 (we check opcode only)
-            };
-            if (memcmp(p, expectedPrologue, 5) != 0)
-            {
-                _MESSAGE("MediumArmor: Calc_ArmorRating prologue bytes: "
-                    "%02X %02X %02X %02X %02X %02X %02X %02X %02X %02X",
-                    p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7], p[8], p[9]);
-                _ERROR("MediumArmor: Calc_ArmorRating prologue mismatch. Skipping hook 4.");
-                goto skip_hook4;
-            }
-
-            s_stolenBytes_CalcAR = 9;  // fld (4) + call rel32 (5)
-
-            // Resolve the absolute target of the call at +4
-            UInt32 callSite = Addr::Calc_ArmorRating + 4;
-            SInt32 origRelOffset = *(SInt32*)(callSite + 1);
-            UInt32 callTarget = callSite + 5 + origRelOffset;  // absolute address of Calc_LuckModifiedSkill
-
-            _MESSAGE("MediumArmor: Calc_ArmorRating call target (LuckModifiedSkill) = %08X", callTarget);
-
-            // ── Build trampoline ───────────────────────────────────────────────
-            //    [0..3]  fld dword ptr [esp+0Ch]    (copied verbatim)
-            //    [4..8]  call <fixed-up rel32>      (recalculated for trampoline addr)
-            //    [9..13] jmp Calc_ArmorRating+9     (resume original body)
-            UInt32 trampSize = 9 + 5;  // stolen bytes + JMP rel32
-            UInt8* tramp = static_cast<UInt8*>(
-                VirtualAlloc(nullptr, trampSize, MEM_COMMIT | MEM_RESERVE,
-                    PAGE_EXECUTE_READWRITE));
-            if (!tramp)
-            {
-                _ERROR("MediumArmor: VirtualAlloc failed for Calc_ArmorRating trampoline.");
-                goto skip_hook4;
-            }
-
-            // Copy the fld instruction verbatim (4 bytes, no relocation needed)
-            memcpy(tramp, p, 4);
-
-            // Write the call with a fixed-up relative offset
-            tramp[4] = 0xE8;
-            UInt32 callInTramp = reinterpret_cast<UInt32>(tramp) + 4;
-            *(SInt32*)(tramp + 5) = static_cast<SInt32>(callTarget - (callInTramp + 5));
-
-            // Write JMP back to Calc_ArmorRating+9
-            UInt32 resumeTarget = Addr::Calc_ArmorRating + 9;
-            tramp[9] = 0xE9;
-            UInt32 jmpInTramp = reinterpret_cast<UInt32>(tramp) + 9;
-            *(SInt32*)(tramp + 10) = static_cast<SInt32>(resumeTarget - (jmpInTramp + 5));
-
-            s_resumeAddr_CalcAR = reinterpret_cast<UInt32>(tramp);
-
-            // Save original bytes for unhooking
-            memcpy(s_origBytes_CalcAR, p, s_stolenBytes_CalcAR);
-
-            // Write JMP to our detour (5 bytes) + NOP remaining 4
-            WriteRelJump(Addr::Calc_ArmorRating,
-                reinterpret_cast<UInt32>(&Detour_CalcArmorRating));
-            for (UInt32 i = 5; i < s_stolenBytes_CalcAR; ++i)
-                SafeWrite8(Addr::Calc_ArmorRating + i, 0x90);
-
-            hook4_ok = true;
-            _MESSAGE("MediumArmor: Hook 4 (Calc_ArmorRating) installed. "
-                "Trampoline at %08X, LuckModSkill at %08X, resume at %08X.",
-                reinterpret_cast<UInt32>(tramp), callTarget, resumeTarget);
+            _ERROR("MediumArmor: VirtualAlloc failed for Calc_ArmorRating trampoline.");
+            return false;
         }
-    skip_hook4:
 
-        // ════════════════════════════════════════════════════════════════════════
-        //  Hook 3: GetArmorSkillAV  (only if hook 4 is active — they're paired)
-        // ════════════════════════════════════════════════════════════════════════
-        if (hook4_ok)
-        {
-            const UInt8 expected[] = {
-                0x8A, 0x41, 0x6A,
-                0x24, 0x80,
-                0xF6, 0xD8,
-                0x1B, 0xC0,
-                0x83, 0xE0, 0xF7,
-                0x83, 0xC0, 0x1B,
-                0xC3
-            };
-            UInt8* p = reinterpret_cast<UInt8*>(Addr::GetArmorSkillAV);
-            _MESSAGE("MediumArmor: GetArmorSkillAV bytes: "
-                "%02X %02X %02X %02X %02X %02X %02X %02X "
-                "%02X %02X %02X %02X %02X %02X %02X %02X",
-                p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7],
-                p[8], p[9], p[10], p[11], p[12], p[13], p[14], p[15]);
-
-            if (memcmp(p, expected, kStolenBytes_SkillAV) != 0)
-            {
-                _ERROR("MediumArmor: GetArmorSkillAV mismatch — skipping hook 3.");
-            }
-            else
-            {
-                memcpy(s_origBytes_SkillAV, p, kStolenBytes_SkillAV);
-                WriteRelJump(Addr::GetArmorSkillAV,
-                    reinterpret_cast<UInt32>(&Detour_GetArmorSkillAV));
-                for (UInt32 i = 5; i < kStolenBytes_SkillAV; ++i)
-                    SafeWrite8(Addr::GetArmorSkillAV + i, 0x90);
-                _MESSAGE("MediumArmor: Hook 3 (GetArmorSkillAV) installed.");
-            }
-        }
-        else
+        memcpy(tramp, p, 4);
+
+        tramp[4] = 0xE8;
+        UInt32 callInTramp = reinterpret_cast<UInt32>(tramp) + 4;
+        *(SInt32*)(tramp + 5) = static_cast<SInt32>(callTarget - (callInTramp + 5));
+
+        UInt32 resumeTarget = Addr::Calc_ArmorRating + kStolenBytes_CalcAR;
+        tramp[9] = 0xE9;
+        UInt32 jmpInTramp = reinterpret_cast<UInt32>(tramp) + 9;
+        *(SInt32*)(tramp + 10) = static_cast<SInt32>(resumeTarget - (jmpInTramp + 5));
+
+        s_resumeAddr_CalcAR = reinterpret_cast<UInt32>(tramp);
+
+        _MESSAGE("MediumArmor: Calc_ArmorRating trampoline at %08X, LuckModSkill at %08X, resume at %08X.",
+            reinterpret_cast<UInt32>(tramp), callTarget, resumeTarget);
+        return true;
+    }
+
+    // ════════════════════════════════════════════════════════════════════════════
+    //  Public API
+    // ════════════════════════════════════════════════════════════════════════════
+
+    bool RegisterHooks()
+    {
+        if (s_hooksRegistered)
+            return true;
+        s_hooksRegistered = true;
+
+        const HookPlan plan = BuildHookPlan();
+        LogHookPlan(plan);
+
+        if (!plan.combat && !plan.heavyFlag && !plan.display)
         {
-            _WARNING("MediumArmor: Hook 4 failed — skipping hook 3 (flag pair). "
-                "Inventory AR display will use light/heavy skill for medium armor.");
+            _MESSAGE("MediumArmor: No medium armour in this load order — no hooks registered.");
+            return true;
         }
 
-        s_hookInstalled = true;
-        _MESSAGE("MediumArmor: All hooks installed.");
+        // ── Init ASM-callable pointers ─────────────────────────────────────────
+        s_fnIsMediumArmor_Sub488CB0 = &IsMediumArmor_Sub488CB0;
+        s_fnIsMediumArmor_IsHeavyArmor = &IsMediumArmor_IsHeavyArmor;
+        s_fnIsMediumArmor_GetArmorSkillAV = &IsMediumArmor_GetArmorSkillAV;
+        s_fnCalcMediumPieceAR = &CalcMediumPieceAR;
+        s_resumeAddr_488CB0 = Addr::Sub_488CB0_Resume;
+
+        using namespace HookControl;
+        using PatchManifest::Entry;
+
+        // Hook 1 is the core of the plugin: if its prologue is off, this is
+        // not the executable we were built against and none of the AR hooks
+        // is written.  The crash fixes are another group and unaffected.
+        PatchManifest::Add(Entry{ GetName(kHook_Sub488CB0), kHook_Sub488CB0,
+            Addr::Sub_488CB0, kExpected_488CB0, sizeof(kExpected_488CB0), kStolenBytes_488CB0,
+            reinterpret_cast<UInt32>(&Detour_Sub488CB0), 0,
+            PatchManifest::kGroup_Hooks, true, plan.combat, &ResolveCombatPointers });
+
+        PatchManifest::Add(Entry{ GetName(kHook_IsHeavyArmor), kHook_IsHeavyArmor,
+            Addr::IsHeavyArmor, kExpected_IsHeavyArmor, sizeof(kExpected_IsHeavyArmor), kStolenBytes_IsHeavyArmor,
+            reinterpret_cast<UInt32>(&Detour_IsHeavyArmor), 0,
+            PatchManifest::kGroup_Hooks, false, plan.heavyFlag, nullptr });
+
+        PatchManifest::Add(Entry{ GetName(kHook_CalcArmorRating), kHook_CalcArmorRating,
+            Addr::Calc_ArmorRating, kExpected_CalcAR, sizeof(kExpected_CalcAR), kStolenBytes_CalcAR,
+            reinterpret_cast<UInt32>(&Detour_CalcArmorRating), 0,
+            PatchManifest::kGroup_Hooks, false, plan.display, &BuildCalcARTrampoline });
+
+        // Hook 3 sets the flag Hook 4 consumes — never one without the other.
+        PatchManifest::Add(Entry{ GetName(kHook_GetArmorSkillAV), kHook_GetArmorSkillAV,
+            Addr::GetArmorSkillAV, kExpected_SkillAV, sizeof(kExpected_SkillAV), kStolenBytes_SkillAV,
+            reinterpret_cast<UInt32>(&Detour_GetArmorSkillAV), 1u << kHook_CalcArmorRating,
+            PatchManifest::kGroup_Hooks, false, plan.display, nullptr });
+
         return true;
     }
 
     void RemoveHooks()
     {
-        if (!s_hookInstalled)
-            return;
+        using namespace HookControl;
 
-        SafeWriteBuf(Addr::Sub_488CB0, s_origBytes_488CB0, kStolenBytes_488CB0);
-        SafeWriteBuf(Addr::IsHeavyArmor, s_origBytes_IHA, kStolenBytes_IsHeavyArmor);
-        SafeWriteBuf(Addr::GetArmorSkillAV, s_origBytes_SkillAV, kStolenBytes_SkillAV);
-        if (s_stolenBytes_CalcAR > 0)
-            SafeWriteBuf(Addr::Calc_ArmorRating, s_origBytes_CalcAR, s_stolenBytes_CalcAR);
+        if (!s_hooksRegistered)
+            return;
 
-        s_hookInstalled = false;
+        PatchManifest::Remove((1u << kHook_Sub488CB0) | (1u << kHook_IsHeavyArmor) |
+            (1u << kHook_GetArmorSkillAV) | (1u << kHook_CalcArmorRating));
         _MESSAGE("MediumArmor: All hooks removed.");
     }
 
-}
\ No newline at end of file
+}
@@ -2,5 +2,7 @@
 
 namespace MediumArmor
 {
-	bool InstallHooks();
+	// Adds the hooks the plan needs to PatchManifest; Install() writes them.
+	bool RegisterHooks();
+	void RemoveHooks();
 }
\ No newline at end of file
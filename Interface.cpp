@@ -0,0 +1,91 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - Interface.cpp
+// ============================================================================
+
+#include "Interface.h"
+#include "MediumArmor.h"
+
+#include "obse/GameObjects.h"
+
+namespace MediumArmor::Interface
+{
+
+    static int __cdecl API_IsMediumArmor(uint32_t formID)
+    {
+        return IsMediumArmorID(formID) ? 1 : 0;
+    }
+
+    static uint32_t __cdecl API_IsMediumArmorBatch(const uint32_t* formIDs, uint32_t count, uint8_t* outFlags)
+    {
+        if (!formIDs || !outFlags)
+            return 0;
+
+        uint32_t hits = 0;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const bool medium = IsMediumArmorID(formIDs[i]);
+            outFlags[i] = medium ? 1 : 0;
+            hits += medium ? 1 : 0;
+        }
+        return hits;
+    }
+
+    static uint32_t __cdecl API_CountEquippedMediumBatch(void* const* actors, uint32_t count, int32_t* outCounts)
+    {
+        if (!actors || !outCounts)
+            return 0;
+
+        uint32_t wearing = 0;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const int n = CountEquippedMediumArmor(static_cast<Actor*>(actors[i]));
+            outCounts[i] = n;
+            if (n > 0)
+                ++wearing;
+        }
+        return wearing;
+    }
+
+    static float __cdecl API_GetMediumArmorSkill()
+    {
+        return GetMediumArmorSkill();
+    }
+
+    static MediumArmorInterface s_interface =
+    {
+        MEDIUMARMOR_API_VERSION,
+        sizeof(MediumArmorInterface),
+        nullptr,
+        nullptr,
+        API_IsMediumArmor,
+        API_IsMediumArmorBatch,
+        API_CountEquippedMediumBatch,
+        API_GetMediumArmorSkill,
+    };
+
+    const MediumArmorInterface* Get()
+    {
+        s_interface.classTable = GetClassTable();
+        s_interface.wearTable = GetWearTable();
+        return &s_interface;
+    }
+
+    bool HandleMessage(OBSEMessagingInterface::Message* msg)
+    {
+        if (!msg || msg->type != MEDIUMARMOR_API_MESSAGE_REQUEST)
+            return false;
+
+        if (!msg->data || msg->dataLen < sizeof(const MediumArmorInterface*))
+        {
+            _WARNING("MediumArmor: Interface request from %s has no output slot.",
+                msg->sender ? msg->sender : "<unknown>");
+            return true;
+        }
+
+        *static_cast<const MediumArmorInterface**>(msg->data) = Get();
+        _MESSAGE("MediumArmor: Interface v%u handed to %s.", MEDIUMARMOR_API_VERSION,
+            msg->sender ? msg->sender : "<unknown>");
+        return true;
+    }
+
+}
@@ -0,0 +1,17 @@
+#pragma once
+// ============================================================================
+//  MediumArmor OBSE Plugin - Interface.h
+//  Hands the MediumArmorAPI interface out to other plugins over messaging.
+// ============================================================================
+
+#include "obse/PluginAPI.h"
+
+#include "MediumArmorAPI.h"
+
+namespace MediumArmor::Interface
+{
+	const MediumArmorInterface* Get();
+
+	// Answers MEDIUMARMOR_API_MESSAGE_REQUEST.  Returns true if handled.
+	bool HandleMessage(OBSEMessagingInterface::Message* msg);
+}
@@ -4,6 +4,15 @@
 
 #include "MediumArmor.h"
 #include "Config.h"
+#include "Classifier.h"
+#include "Trace.h"
+#include "Timing.h"
+#include "ClassificationCache.h"
+#include "SkillCurve.h"
+#include "Progression.h"
+#include "SkillSync.h"
+#include "WearTable.h"
+#include "ChangeEpochs.h"
 
 #include "obse/GameAPI.h"
 #include "obse/GameForms.h"
@@ -11,14 +20,33 @@
 
 #include "OBSEKeywords/KeywordAPI.h"
 
+#include "obse/GameData.h"
+
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <windows.h>
 
 namespace MediumArmor
 {
 
     static float s_mediumArmorSkill = 5.0f;
 
+    // Classification table: sorted medium form IDs, built after data load.
+    static std::vector<UInt32>   s_mediumFormIDs;
+    static MediumArmorClassTable s_classTable = {};
+
+    // Wear summaries: open-addressed by actor refID, fixed storage so the
+    // pointer handed out through MediumArmorAPI never moves.
+    constexpr UInt32 kWearTableCapacity = 1024;  // power of two
+
+    static MediumArmorWearSummary s_wearSummaries[kWearTableCapacity] = {};
+    static MediumArmorWearTable   s_wearTable = { s_wearSummaries, kWearTableCapacity };
+
+    static WearCountStats s_wearCountStats = {};
+
     bool HasKeyword(TESForm* form, const char* keyword)
     {
         if (KeywordAPI::HasKeyword(form->refID, keyword))
@@ -29,11 +57,7 @@ namespace MediumArmor
         if (!form || !keyword)
             return false;
 
-        const char* editorID = form->GetEditorID();
-        if (editorID && strstr(editorID, keyword))
-            return true;
-
-        return false;
+        return Classifier::EditorIDHasKeyword(form->GetEditorID(), keyword);
     }
 
     bool IsMediumArmor(TESForm* form)
@@ -44,7 +68,14 @@ namespace MediumArmor
         if (form->typeID != kFormType_Armor)
             return false;
 
-        return HasKeyword(form, kMediumArmorKeyword);
+        return Classifier::IsMedium(s_classTable, form->refID,
+            [form] { return HasKeyword(form, kMediumArmorKeyword); });
+    }
+
+    bool IsMediumArmorID(UInt32 formID)
+    {
+        return Classifier::IsMedium(s_classTable, formID,
+            [formID] { return IsMediumArmor(LookupFormByID(formID)); });
     }
 
     float GetMediumArmorSkill()
@@ -52,26 +83,40 @@ namespace MediumArmor
         return s_mediumArmorSkill;
     }
 
+    float GetEffectiveMediumArmorSkill()
+    {
+        return Progression::EffectiveSkill(s_mediumArmorSkill, kARMultiplier, kARFlat);
+    }
+
     void SetMediumArmorSkill(float value)
     {
         s_mediumArmorSkill = std::clamp(value, 0.0f, 100.0f);
+        ChangeEpochs::NoteSkill(s_mediumArmorSkill);
+        SkillSync::NotifySkillChanged(GetEffectiveMediumArmorSkill());
     }
 
     void SyncSkillFromMenuQue()
     {
-        // TODO
+        // Without a read-back the plugin's value wins; make sure the UI has it.
+        float effective = 0.0f;
+        if (!SkillSync::PullFromUI(effective) || kARMultiplier == 0.0f)
+        {
+            SkillSync::NotifySkillChanged(GetEffectiveMediumArmorSkill());
+            return;
+        }
+
+        s_mediumArmorSkill = Progression::BaseSkill(effective, kARMultiplier, kARFlat);
+        ChangeEpochs::NoteSkill(s_mediumArmorSkill);
     }
 
     float CalculateXPGain(float currentSkill)
     {
-        float factor = 1.0f - kXPSkillFactor * (currentSkill / 100.0f);
-        return kXPPerHit * std::max(factor, 0.05f);
+        return SkillCurve::XPGain(currentSkill);
     }
 
     void AwardXP(float xp)
     {
-        // TODO
-        SetMediumArmorSkill(GetMediumArmorSkill() + xp);
+        SetMediumArmorSkill(SkillCurve::Advance(GetMediumArmorSkill(), xp));
     }
 
     static bool IsEntryEquipped(ExtraContainerChanges::EntryData* entry)
@@ -90,39 +135,179 @@ namespace MediumArmor
         return false;
     }
 
-
+    // There is no equip or container change signal to cache against, so
+    // every count walks objList and the extra lists of each armour entry.
     int CountEquippedMediumArmor(Actor* actor)
     {
         if (!actor)
             return 0;
 
-        int count = 0;
+        MA_TRACE_SCOPE("CountEquippedMediumArmor");
 
         ExtraContainerChanges* xChanges = static_cast<ExtraContainerChanges*>(
             actor->baseExtraList.GetByType(kExtraData_ContainerChanges));
 
-        if (!xChanges || !xChanges->data || !xChanges->data->objList)
-            return 0;
-
-        for (auto iter = xChanges->data->objList->Begin(); !iter.End(); ++iter)
+        int count = 0;
+        UInt32 entries = 0;
+        if (xChanges && xChanges->data && xChanges->data->objList)
         {
-            ExtraContainerChanges::EntryData* entry = iter.Get();
-            if (!entry || !entry->type)
-                continue;
-
-            if (!IsEntryEquipped(entry))
-                continue;
-
-            if (IsMediumArmor(entry->type))
-                ++count;
+            for (auto iter = xChanges->data->objList->Begin(); !iter.End(); ++iter, ++entries)
+            {
+                // Only armour is worn-and-counted; skip the rest before
+                // touching its extra lists.
+                ExtraContainerChanges::EntryData* entry = iter.Get();
+                if (!entry || !entry->type || entry->type->typeID != kFormType_Armor)
+                    continue;
+
+                if (IsEntryEquipped(entry) && IsMediumArmor(entry->type))
+                    ++count;
+            }
         }
 
+        ++s_wearCountStats.counts;
+        s_wearCountStats.entries += entries;
+        WearTable::Record(s_wearSummaries, kWearTableCapacity, actor->refID, count);
+        ChangeEpochs::ObserveCount(actor, count);
         return count;
     }
 
+    const WearCountStats& GetWearCountStats()
+    {
+        return s_wearCountStats;
+    }
+
+    void ClearWearState()
+    {
+        std::memset(s_wearSummaries, 0, sizeof(s_wearSummaries));
+    }
+
     bool IsWearingMediumArmor(Actor* actor)
     {
         return CountEquippedMediumArmor(actor) > 0;
     }
 
+    // Everything the classification depends on: the cache format and
+    // classifier versions, the keyword, every active plugin file (name, size,
+    // timestamp) and the keyword config files.
+    static UInt64 ComputeClassificationFingerprint()
+    {
+        UInt64 hash = ClassificationCache::HashString(kMediumArmorKeyword,
+            ClassificationCache::FingerprintSeed());
+
+        if (DataHandler* data = *g_dataHandler)
+        {
+            const UInt32 modCount = data->GetActiveModCount();
+            for (UInt32 i = 0; i < modCount; ++i)
+            {
+                char path[MAX_PATH];
+                std::snprintf(path, sizeof(path), "Data\\%s", data->GetNthModName(i));
+                hash = ClassificationCache::HashFileStamp(path, hash);
+            }
+        }
+
+        // Directory enumeration order isn't guaranteed; combine order-independently.
+        UInt64 configHash = 0;
+        char pattern[MAX_PATH];
+        std::snprintf(pattern, sizeof(pattern), "%s\\*.ini", kKeywordConfigDir);
+
+        WIN32_FIND_DATAA find;
+        HANDLE search = FindFirstFileA(pattern, &find);
+        if (search != INVALID_HANDLE_VALUE)
+        {
+            do
+            {
+                char path[MAX_PATH];
+                std::snprintf(path, sizeof(path), "%s\\%s", kKeywordConfigDir, find.cFileName);
+                configHash += ClassificationCache::HashFileStamp(path, ClassificationCache::kFnvOffset);
+            } while (FindNextFileA(search, &find));
+            FindClose(search);
+        }
+
+        return ClassificationCache::HashBytes(&configHash, sizeof(configHash), hash);
+    }
+
+    void BuildClassificationTable()
+    {
+        const UInt64 start = Timing::NowNs();
+        const UInt64 fingerprint = ComputeClassificationFingerprint();
+
+        const UInt32* mappedIDs = nullptr;
+        UInt32 mappedCount = 0;
+        if (ClassificationCache::Map(kClassCachePath, fingerprint, &mappedIDs, &mappedCount))
+        {
+            s_mediumFormIDs.clear();
+            s_classTable.formIDs = mappedIDs;
+            s_classTable.count = mappedCount;
+            ++s_classTable.generation;
+
+            _MESSAGE("MediumArmor: Classification table mapped from %s (%u medium forms, %.2f ms).",
+                kClassCachePath, s_classTable.count, (Timing::NowNs() - start) / 1e6);
+            return;
+        }
+
+        std::vector<UInt32> formIDs;
+        ForEachArmorForm([&formIDs](TESForm* form)
+            {
+                if (HasKeyword(form, kMediumArmorKeyword))
+                    formIDs.push_back(form->refID);
+            });
+
+        std::sort(formIDs.begin(), formIDs.end());
+        formIDs.erase(std::unique(formIDs.begin(), formIDs.end()), formIDs.end());
+        s_mediumFormIDs.swap(formIDs);
+
+        s_classTable.formIDs = s_mediumFormIDs.data();
+        s_classTable.count = static_cast<UInt32>(s_mediumFormIDs.size());
+        ++s_classTable.generation;
+
+        const bool cached = ClassificationCache::Write(kClassCachePath, fingerprint,
+            s_classTable.formIDs, s_classTable.count);
+
+        _MESSAGE("MediumArmor: Classification table built (%u medium forms, generation %u, %.2f ms)%s.",
+            s_classTable.count, s_classTable.generation, (Timing::NowNs() - start) / 1e6,
+            cached ? "" : " - cache write failed");
+    }
+
+    double MeasureIsMediumArmorNs(UInt32 maxForms)
+    {
+        std::vector<TESForm*> sample;
+        sample.reserve(maxForms);
+        ForEachArmorForm([&sample, maxForms](TESForm* form)
+            {
+                if (sample.size() < maxForms)
+                    sample.push_back(form);
+            });
+
+        if (sample.empty())
+            return 0.0;
+
+        constexpr UInt32 kPasses = 8;
+        volatile UInt32 sink = 0;
+
+        const UInt64 start = Timing::NowNs();
+        for (UInt32 pass = 0; pass < kPasses; ++pass)
+        {
+            for (TESForm* form : sample)
+                sink += IsMediumArmor(form) ? 1 : 0;
+        }
+        const UInt64 elapsed = Timing::NowNs() - start;
+
+        return static_cast<double>(elapsed) / (kPasses * sample.size());
+    }
+
+    bool IsClassificationTableBuilt()
+    {
+        return s_classTable.generation != 0;
+    }
+
+    const MediumArmorClassTable* GetClassTable()
+    {
+        return &s_classTable;
+    }
+
+    const MediumArmorWearTable* GetWearTable()
+    {
+        return &s_wearTable;
+    }
+
 }
\ No newline at end of file
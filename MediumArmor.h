@@ -2,16 +2,45 @@
 
 #include "obse/GameForms.h"
 #include "obse/GameObjects.h"
+#include "obse/GameData.h"
+
+#include "MediumArmorAPI.h"
 
 namespace MediumArmor
 {
 
 	bool IsMediumArmor(TESForm* form);
 
+	bool IsMediumArmorID(UInt32 formID);
+
 	bool HasKeyword(TESForm* form, const char* keyword);
 
+	// Byte +0x6A bit 7 of an armour form: what vanilla IsHeavyArmor reads.
+	inline bool HasHeavyFlag(TESForm* armorForm)
+	{
+		return (*(reinterpret_cast<UInt8*>(armorForm) + 0x6A) & 0x80) != 0;
+	}
+
+	// Calls fn(TESForm*) for every armour form in the bound object list.
+	template <typename Fn>
+	void ForEachArmorForm(Fn&& fn)
+	{
+		DataHandler* data = *g_dataHandler;
+		if (!data || !data->boundObjects)
+			return;
+
+		for (TESObject* obj = data->boundObjects->first; obj; obj = obj->next)
+		{
+			if (obj->typeID == kFormType_Armor)
+				fn(obj);
+		}
+	}
+
 	float GetMediumArmorSkill();
 
+	// Skill after kARMultiplier/kARFlat, clamped to 0-100.
+	float GetEffectiveMediumArmorSkill();
+
 	void  SetMediumArmorSkill(float value);
 
 	void  SyncSkillFromMenuQue();
@@ -25,4 +54,26 @@ namespace MediumArmor
 
 	bool  IsWearingMediumArmor(Actor* actor);
 
+	struct WearCountStats
+	{
+		UInt32 counts;     // CountEquippedMediumArmor calls that walked an inventory
+		UInt64 entries;    // objList entries walked by them
+	};
+
+	const WearCountStats& GetWearCountStats();
+
+	// LoadGame: the summaries hold the old session's refs.
+	void  ClearWearState();
+
+
+	void  BuildClassificationTable();
+
+	bool  IsClassificationTableBuilt();
+
+	double MeasureIsMediumArmorNs(UInt32 maxForms);
+
+	const MediumArmorClassTable* GetClassTable();
+
+	const MediumArmorWearTable*  GetWearTable();
+
 }
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+// ============================================================================
+//  MediumArmor OBSE Plugin - MediumArmorAPI.h
+//
+//  Versioned C interface for other OBSE plugins.  Copy this header into the
+//  consuming plugin; it only depends on <stdint.h>.
+//
+//  Requesting the interface (any time after kMessage_PostLoad):
+//
+//      const MediumArmorInterface* api = nullptr;
+//      msg->Dispatch(myHandle, MEDIUMARMOR_API_MESSAGE_REQUEST,
+//                    &api, sizeof(api), "MediumArmor");
+//
+//  Dispatch is synchronous, so `api` is filled in when it returns.  All
+//  pointers stay valid for the life of the process.  Tables are read-only
+//  views into the plugin's own storage - read them from the game thread.
+// ============================================================================
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MEDIUMARMOR_API_VERSION          1
+#define MEDIUMARMOR_API_MESSAGE_REQUEST  0x4D414931u   /* 'MAI1' */
+
+/* Sorted (ascending) form IDs of every armour form classified as medium.
+   Rebuilt once per session after data load; `generation` is 0 until then
+   and is bumped on every rebuild, so consumers can detect a stale copy. */
+typedef struct MediumArmorClassTable
+{
+    const uint32_t*  formIDs;
+    uint32_t         count;
+    uint32_t         generation;
+} MediumArmorClassTable;
+
+/* Last observed equipped-medium count for an actor.  A slot with
+   actorRefID == 0 is empty.  `stamp` is bumped on every refresh. */
+typedef struct MediumArmorWearSummary
+{
+    uint32_t  actorRefID;
+    uint16_t  mediumCount;
+    uint16_t  reserved;
+    uint32_t  stamp;
+} MediumArmorWearSummary;
+
+typedef struct MediumArmorWearTable
+{
+    const MediumArmorWearSummary*  entries;
+    uint32_t                       capacity;
+} MediumArmorWearTable;
+
+typedef struct MediumArmorInterface
+{
+    uint32_t  version;      /* MEDIUMARMOR_API_VERSION */
+    uint32_t  size;         /* sizeof(MediumArmorInterface) */
+
+    const MediumArmorClassTable*  classTable;
+    const MediumArmorWearTable*   wearTable;
+
+    /* Returns non-zero if the form ID is classified as medium armour. */
+    int       (*IsMediumArmor)(uint32_t formID);
+
+    /* Writes 0/1 per form ID into outFlags.  Returns the number of hits. */
+    uint32_t  (*IsMediumArmorBatch)(const uint32_t* formIDs, uint32_t count, uint8_t* outFlags);
+
+    /* `actors` are Actor* from the game.  Writes equipped-medium counts into
+       outCounts (refreshing the wear table).  Returns the number of actors
+       wearing at least one medium piece. */
+    uint32_t  (*CountEquippedMediumBatch)(void* const* actors, uint32_t count, int32_t* outCounts);
+
+    float     (*GetMediumArmorSkill)(void);
+} MediumArmorInterface;
+
+#ifdef __cplusplus
+}
+#endif
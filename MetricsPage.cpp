@@ -0,0 +1,128 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - MetricsPage.cpp
+// ============================================================================
+
+#include "MetricsPage.h"
+#include "ARCache.h"
+#include "FrameClock.h"
+#include "HookControl.h"
+#include "MediumArmor.h"
+#include "Timing.h"
+#include "WarmUp.h"
+
+#include <algorithm>
+#include <windows.h>
+
+namespace MediumArmor::MetricsPage
+{
+
+    static_assert(HookControl::kHook_Count <= kMaxHooks, "metrics page has too few hook slots");
+
+    static HANDLE   s_mapping = nullptr;
+    static Page*    s_page = nullptr;
+    static bool     s_listening = false;
+    static uint32_t s_publishCount = 0;
+    static uint64_t s_lastCalloutNs = 0;
+    static uint64_t s_calloutMaxNs = 0;
+
+    static uint64_t TotalCalloutNs()
+    {
+        uint64_t total = 0;
+        for (UInt32 i = 0; i < HookControl::kHook_Count; ++i)
+            total += HookControl::GetCalloutNs(i);
+        return total;
+    }
+
+    static void OnFrame(uint32_t frame)
+    {
+        if (!s_page)
+            return;
+
+        Payload payload = {};
+        payload.frame = frame;
+        payload.publishCount = ++s_publishCount;
+
+        payload.hookCount = HookControl::kHook_Count;
+        for (UInt32 i = 0; i < HookControl::kHook_Count; ++i)
+        {
+            payload.hookCalls[i] = HookControl::GetCallCount(i);
+            payload.hookEnabled[i] = HookControl::IsEnabled(i) ? 1 : 0;
+        }
+
+        const ARCache::Stats& display = ARCache::GetDisplayStats();
+        const WearCountStats& wear = GetWearCountStats();
+        payload.arDisplayHits = display.hits;
+        payload.arDisplayMisses = display.misses;
+        payload.wearCounts = wear.counts;
+        payload.wearEntries = static_cast<uint32_t>(wear.entries);
+        payload.warmUpPending = WarmUp::GetPending();
+
+        payload.skill = GetMediumArmorSkill();
+        payload.effectiveSkill = GetEffectiveMediumArmorSkill();
+
+        // Publishes run once per frame, so the callout time since the last
+        // one is the game's hook cost over the frame just gone.
+        const uint64_t calloutNs = TotalCalloutNs();
+        payload.frameCalloutNs = calloutNs - s_lastCalloutNs;
+        s_lastCalloutNs = calloutNs;
+        s_calloutMaxNs = std::max(s_calloutMaxNs, payload.frameCalloutNs);
+        payload.frameCalloutMaxNs = s_calloutMaxNs;
+        payload.publishedAtNs = Timing::NowNs();
+
+        // This listener runs inside the tick it would measure; report the
+        // previous frame's work.
+        payload.listenerWorkNs = FrameClock::LastWorkNs();
+
+        Publish(s_page, payload);
+    }
+
+    bool Start()
+    {
+        if (s_page)
+            return true;
+
+        s_mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, sizeof(Page), kWin32Name);
+        if (!s_mapping)
+        {
+            _ERROR("MediumArmor: could not create metrics page \"%s\" (error %u).", kWin32Name, GetLastError());
+            return false;
+        }
+        if (GetLastError() == ERROR_ALREADY_EXISTS)
+            _WARNING("MediumArmor: metrics page \"%s\" already exists - taking it over.", kWin32Name);
+
+        s_page = static_cast<Page*>(MapViewOfFile(s_mapping, FILE_MAP_WRITE, 0, 0, sizeof(Page)));
+        if (!s_page)
+        {
+            _ERROR("MediumArmor: could not map metrics page (error %u).", GetLastError());
+            CloseHandle(s_mapping);
+            s_mapping = nullptr;
+            return false;
+        }
+
+        InitPage(s_page);
+        s_lastCalloutNs = TotalCalloutNs();
+
+        if (!s_listening)
+            s_listening = FrameClock::AddListener(&OnFrame);
+
+        _MESSAGE("MediumArmor: publishing metrics to \"%s\" (%u bytes, version %u).",
+            kWin32Name, static_cast<UInt32>(sizeof(Page)), kVersion);
+        return true;
+    }
+
+    void Stop()
+    {
+        if (s_page)
+            UnmapViewOfFile(s_page);
+        if (s_mapping)
+            CloseHandle(s_mapping);
+        s_page = nullptr;
+        s_mapping = nullptr;
+    }
+
+    bool IsRunning()
+    {
+        return s_page != nullptr;
+    }
+
+}
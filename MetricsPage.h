@@ -0,0 +1,123 @@
+#pragma once
+// ============================================================================
+//  MediumArmor OBSE Plugin - MetricsPage.h
+//
+//  Live counters in a named shared-memory page, for overlays watching long
+//  soak sessions without scraping MediumArmor.log.  The plugin republishes
+//  the page once per plugin frame; layout (little-endian, fixed offsets):
+//
+//      Header  { magic, version, size, sequence }
+//      Payload { frame, hook calls, cache counters, skill, callout time, ... }
+//
+//  Writes are a seqlock: `sequence` is odd while the payload is being
+//  copied in.  Readers copy the payload and retry if the sequence was odd
+//  or changed meanwhile, so the game thread never waits on a reader.
+//
+//  A new field goes at the end of Payload (taken from `reserved`) without a
+//  version bump; changing or removing one bumps kVersion.  The layout and
+//  seqlock are platform-neutral; tools/MetricsReader builds them on Linux
+//  against a POSIX shm segment of the same layout.
+// ============================================================================
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+namespace MediumArmor::MetricsPage
+{
+	constexpr uint32_t kMagic = 0x504D414D;     // 'MAMP'
+	constexpr uint32_t kVersion = 5;
+	constexpr uint32_t kMaxHooks = 8;
+
+	constexpr const char* kWin32Name = "Local\\MediumArmorMetrics";
+	constexpr const char* kPosixName = "/MediumArmorMetrics";
+
+	struct Payload
+	{
+		uint32_t frame;                 // FrameClock frame of this update
+		uint32_t publishCount;
+
+		uint32_t hookCount;
+		uint32_t hookCalls[kMaxHooks];  // g_hookCalls, HookControl::HookId order
+		uint8_t  hookEnabled[kMaxHooks];
+
+		uint32_t arDisplayHits;
+		uint32_t arDisplayMisses;
+		uint32_t wearCounts;            // CountEquippedMediumArmor inventory walks
+		uint32_t wearEntries;           // objList entries they walked (wraps)
+		uint32_t warmUpPending;
+
+		float    skill;                 // base medium skill
+		float    effectiveSkill;        // after kARMultiplier/kARFlat
+		uint32_t pad0;
+
+		uint64_t frameCalloutNs;        // hook callout time since the last publish (all hooks)
+		uint64_t frameCalloutMaxNs;
+		uint64_t publishedAtNs;         // Timing::NowNs() of the writer
+		uint64_t listenerWorkNs;        // last frame's FrameClock listeners (warm-up, sync, ...)
+
+		uint32_t reserved[22];
+	};
+
+	struct Page
+	{
+		uint32_t              magic;
+		uint32_t              version;
+		uint32_t              size;     // sizeof(Page)
+		std::atomic<uint32_t> sequence;
+		Payload               payload;
+	};
+
+	static_assert(std::atomic<uint32_t>::is_always_lock_free, "seqlock needs a lock-free counter");
+	static_assert(sizeof(Payload) == 208, "metrics payload layout changed");
+	static_assert(sizeof(Page) == 224, "metrics page layout changed");
+
+	inline void InitPage(Page* page)
+	{
+		std::memset(static_cast<void*>(page), 0, sizeof(Page));
+		page->magic = kMagic;
+		page->version = kVersion;
+		page->size = sizeof(Page);
+	}
+
+	// Single writer.
+	inline void Publish(Page* page, const Payload& payload)
+	{
+		const uint32_t seq = page->sequence.load(std::memory_order_relaxed);
+		page->sequence.store(seq + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		std::memcpy(&page->payload, &payload, sizeof(Payload));
+
+		page->sequence.store(seq + 2, std::memory_order_release);
+	}
+
+	// False if the page is not ours or no consistent copy was had in
+	// `attempts` tries (the writer kept overlapping).
+	inline bool Read(const Page* page, Payload& out, uint32_t attempts = 64)
+	{
+		if (page->magic != kMagic || page->version != kVersion || page->size != sizeof(Page))
+			return false;
+
+		for (uint32_t i = 0; i < attempts; ++i)
+		{
+			const uint32_t before = page->sequence.load(std::memory_order_acquire);
+			if (before & 1)
+				continue;
+
+			std::memcpy(&out, &page->payload, sizeof(Payload));
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (page->sequence.load(std::memory_order_relaxed) == before)
+				return true;
+		}
+		return false;
+	}
+
+#ifdef _WIN32
+	// Plugin side: creates the named mapping and republishes every frame.
+	bool Start();
+	void Stop();
+	bool IsRunning();
+#endif
+}
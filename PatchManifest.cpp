@@ -0,0 +1,290 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - PatchManifest.cpp
+// ============================================================================
+
+#include "PatchManifest.h"
+#include "Timing.h"
+
+#include "obse_common/SafeWrite.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace MediumArmor::PatchManifest
+{
+
+    struct Slot
+    {
+        Entry  entry;
+        Status status;
+        UInt8  original[kMaxStolenBytes];
+    };
+
+    static Slot   s_slots[kMaxEntries] = {};
+    static UInt32 s_slotCount = 0;
+    static bool   s_ran = false;
+    static bool   s_result = false;
+
+    static Slot* FindSlot(UInt32 id)
+    {
+        for (UInt32 i = 0; i < s_slotCount; ++i)
+        {
+            if (s_slots[i].entry.id == id)
+                return &s_slots[i];
+        }
+        return nullptr;
+    }
+
+    static void LogBytes(const char* label, const UInt8* bytes, UInt32 len)
+    {
+        char text[kMaxStolenBytes * 3 + 1] = {};
+        for (UInt32 i = 0; i < len && i < kMaxStolenBytes; ++i)
+            sprintf_s(text + i * 3, sizeof(text) - i * 3, "%02X ", bytes[i]);
+        _MESSAGE("    %s: %s", label, text);
+    }
+
+    bool Add(const Entry& entry)
+    {
+        if (s_slotCount == kMaxEntries || FindSlot(entry.id))
+            return false;
+
+        if (entry.stolenLen < 5 || entry.stolenLen > kMaxStolenBytes ||
+            entry.expectedLen > entry.stolenLen)
+        {
+            _ERROR("PatchManifest: %s has an invalid stolen length (%u).", entry.name, entry.stolenLen);
+            return false;
+        }
+
+        if (entry.group >= kGroup_Count)
+        {
+            _ERROR("PatchManifest: %s has an invalid group (%u).", entry.name, entry.group);
+            return false;
+        }
+
+        Slot& slot = s_slots[s_slotCount++];
+        slot.entry = entry;
+        slot.status = entry.enabled ? Status::Pending : Status::Skipped;
+        return true;
+    }
+
+    // ── Phase 1: one address-ordered pass over the code image ──────────────
+    // Returns the mask of groups with a failed required entry.
+    static UInt32 Verify()
+    {
+        Slot* order[kMaxEntries];
+        UInt32 count = 0;
+        for (UInt32 i = 0; i < s_slotCount; ++i)
+        {
+            if (s_slots[i].status == Status::Pending)
+                order[count++] = &s_slots[i];
+        }
+
+        std::sort(order, order + count, [](const Slot* a, const Slot* b)
+            {
+                return a->entry.address < b->entry.address;
+            });
+
+        UInt32 failedGroups = 0;
+        UInt32 prevEnd = 0;
+        for (UInt32 i = 0; i < count; ++i)
+        {
+            Slot& slot = *order[i];
+            const Entry& e = slot.entry;
+            const UInt8* code = reinterpret_cast<const UInt8*>(e.address);
+
+            const bool overlaps = e.address < prevEnd;
+            prevEnd = std::max(prevEnd, e.address + e.stolenLen);
+
+            if (overlaps || memcmp(code, e.expected, e.expectedLen) != 0)
+            {
+                _ERROR("PatchManifest: %s at %08X %s.", e.name, e.address,
+                    overlaps ? "overlaps another entry" : "does not match");
+                LogBytes("expected", e.expected, e.expectedLen);
+                LogBytes("found   ", code, e.stolenLen);
+
+                slot.status = Status::Mismatch;
+                if (e.required)
+                    failedGroups |= 1u << e.group;
+                continue;
+            }
+
+            memcpy(slot.original, code, e.stolenLen);
+        }
+
+        return failedGroups;
+    }
+
+    // ── Phase 2: trampolines and anything else that must exist pre-write ───
+    static void Prepare()
+    {
+        for (UInt32 i = 0; i < s_slotCount; ++i)
+        {
+            Slot& slot = s_slots[i];
+            if (slot.status != Status::Pending || !slot.entry.prepare)
+                continue;
+
+            if (!slot.entry.prepare())
+            {
+                _ERROR("PatchManifest: %s prepare step failed.", slot.entry.name);
+                slot.status = Status::PrepareFailed;
+            }
+        }
+    }
+
+    static void WriteEntry(Slot& slot)
+    {
+        const Entry& e = slot.entry;
+        WriteRelJump(e.address, e.detour);
+        for (UInt32 i = 5; i < e.stolenLen; ++i)
+            SafeWrite8(e.address + i, 0x90);
+        slot.status = Status::Installed;
+    }
+
+    // ── Phase 3: write in dependency order ─────────────────────────────────
+    static UInt32 Write()
+    {
+        UInt32 installedMask = 0;
+        UInt32 written = 0;
+
+        for (bool progress = true; progress; )
+        {
+            progress = false;
+            for (UInt32 i = 0; i < s_slotCount; ++i)
+            {
+                Slot& slot = s_slots[i];
+                if (slot.status != Status::Pending)
+                    continue;
+
+                const UInt32 deps = slot.entry.dependsMask;
+                if ((installedMask & deps) == deps)
+                {
+                    WriteEntry(slot);
+                    installedMask |= 1u << slot.entry.id;
+                    ++written;
+                    progress = true;
+                }
+            }
+        }
+
+        // Anything still pending waits on an entry that never got written.
+        for (UInt32 i = 0; i < s_slotCount; ++i)
+        {
+            Slot& slot = s_slots[i];
+            if (slot.status != Status::Pending)
+                continue;
+
+            slot.status = Status::DependencyFailed;
+            _WARNING("PatchManifest: %s skipped - a dependency was not installed.", slot.entry.name);
+        }
+
+        return written;
+    }
+
+    static const char* StatusName(Status status)
+    {
+        switch (status)
+        {
+        case Status::Pending:          return "pending";
+        case Status::Skipped:          return "skipped (plan)";
+        case Status::Mismatch:         return "MISMATCH";
+        case Status::PrepareFailed:    return "PREPARE FAILED";
+        case Status::DependencyFailed: return "dependency missing";
+        case Status::Aborted:          return "aborted";
+        case Status::Installed:        return "installed";
+        }
+        return "?";
+    }
+
+    bool Install()
+    {
+        if (s_ran)
+            return s_result;
+        s_ran = true;
+
+        const UInt64 t0 = Timing::NowNs();
+        const UInt32 failedGroups = Verify();
+        const UInt64 t1 = Timing::NowNs();
+
+        if (failedGroups)
+        {
+            for (UInt32 i = 0; i < s_slotCount; ++i)
+            {
+                Slot& slot = s_slots[i];
+                if (slot.status == Status::Pending && (failedGroups & (1u << slot.entry.group)))
+                    slot.status = Status::Aborted;
+            }
+            _ERROR("PatchManifest: a required entry failed verification; its group (mask %X) is not installed.",
+                failedGroups);
+        }
+
+        Prepare();
+        const UInt64 t2 = Timing::NowNs();
+        const UInt32 written = Write();
+        const UInt64 t3 = Timing::NowNs();
+
+        _MESSAGE("PatchManifest: %u entries - verify %.3f ms, prepare %.3f ms, write %.3f ms.",
+            s_slotCount, (t1 - t0) / 1e6, (t2 - t1) / 1e6, (t3 - t2) / 1e6);
+
+        for (UInt32 i = 0; i < s_slotCount; ++i)
+        {
+            const Entry& e = s_slots[i].entry;
+            _MESSAGE("  %-24s %08X  %s", e.name, e.address, StatusName(s_slots[i].status));
+        }
+        _MESSAGE("PatchManifest: %u of %u entries installed.", written, s_slotCount);
+
+        s_result = failedGroups == 0;
+        return s_result;
+    }
+
+    static bool HasInstalledDependent(UInt32 id)
+    {
+        for (UInt32 i = 0; i < s_slotCount; ++i)
+        {
+            const Slot& slot = s_slots[i];
+            if (slot.status == Status::Installed && (slot.entry.dependsMask & (1u << id)))
+                return true;
+        }
+        return false;
+    }
+
+    // Write() in reverse: an entry comes off once nothing installed
+    // depends on it.
+    void Remove(UInt32 idMask)
+    {
+        for (bool progress = true; progress; )
+        {
+            progress = false;
+            for (UInt32 i = 0; i < s_slotCount; ++i)
+            {
+                Slot& slot = s_slots[i];
+                if (slot.status != Status::Installed || !(idMask & (1u << slot.entry.id)) ||
+                    HasInstalledDependent(slot.entry.id))
+                    continue;
+
+                SafeWriteBuf(slot.entry.address, slot.original, slot.entry.stolenLen);
+                slot.status = Status::Pending;
+                progress = true;
+            }
+        }
+
+        for (UInt32 i = 0; i < s_slotCount; ++i)
+        {
+            const Slot& slot = s_slots[i];
+            if (slot.status == Status::Installed && (idMask & (1u << slot.entry.id)))
+                _WARNING("PatchManifest: %s left installed - an entry outside the removal depends on it.",
+                    slot.entry.name);
+        }
+    }
+
+    Status GetStatus(UInt32 id)
+    {
+        const Slot* slot = FindSlot(id);
+        return slot ? slot->status : Status::Pending;
+    }
+
+    bool IsInstalled(UInt32 id)
+    {
+        return GetStatus(id) == Status::Installed;
+    }
+
+}
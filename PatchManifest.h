@@ -0,0 +1,73 @@
+#pragma once
+// ============================================================================
+//  MediumArmor OBSE Plugin - PatchManifest.h
+//
+//  One table for every code patch the plugin writes: MediumArmor's hooks and
+//  the GPEngineFixes crash fixes.  Modules describe their patches with Add();
+//  Install() then
+//
+//      1. verifies every entry against the code image in one address-ordered
+//         pass (expected bytes, overlapping stolen ranges),
+//      2. runs each entry's prepare step (trampolines, resolved pointers),
+//      3. writes the jumps in dependency order,
+//
+//  and logs the time spent in each phase.  A new fix is a new entry.
+//
+//  Entries belong to a group.  A required entry that fails verification
+//  aborts its own group only: a byte mismatch under MediumArmor's hooks
+//  leaves the crash fixes to install or fail on their own bytes.
+// ============================================================================
+
+namespace MediumArmor::PatchManifest
+{
+	constexpr UInt32 kMaxEntries = 32;
+	constexpr UInt32 kMaxStolenBytes = 16;
+
+	enum Group : UInt8
+	{
+		kGroup_Hooks,           // MediumArmor's AR hooks
+		kGroup_EngineFixes,     // GPEngineFixes crash fixes
+		kGroup_Count,
+	};
+
+	struct Entry
+	{
+		const char*  name;
+		UInt32       id;            // HookControl::HookId - unique per entry
+		UInt32       address;
+		const UInt8* expected;      // bytes that must be at `address`
+		UInt32       expectedLen;   // may be shorter than stolenLen (e.g. rel32 operands)
+		UInt32       stolenLen;     // rel jump + NOP pad, at most kMaxStolenBytes
+		UInt32       detour;
+		UInt32       dependsMask;   // (1 << id) of entries that must be installed first
+		UInt8        group;
+		bool         required;      // a failed check aborts the entry's group
+		bool         enabled;       // false = left out by the caller's plan
+		bool       (*prepare)();    // optional; runs after verification, false = skip
+	};
+
+	enum class Status : UInt8
+	{
+		Pending,
+		Skipped,            // not enabled
+		Mismatch,           // expected bytes differ or ranges overlap
+		PrepareFailed,
+		DependencyFailed,
+		Aborted,            // a required entry in the group failed
+		Installed,
+	};
+
+	bool   Add(const Entry& entry);
+
+	// Returns false if a required entry failed; nothing of its group is
+	// written then.  Other groups install regardless.
+	bool   Install();
+
+	// Restores the entries in idMask, dependents before what they depend
+	// on.  An entry another installed entry outside idMask still depends
+	// on is left in place.
+	void   Remove(UInt32 idMask);
+
+	Status GetStatus(UInt32 id);
+	bool   IsInstalled(UInt32 id);
+}
@@ -1,5 +1,7 @@
 #include "Patches.h"
 #include <obse_common/SafeWrite.h>
+#include "HookControl.h"
+#include "PatchManifest.h"
 
 namespace GPEngineFixes::Patches
 {
@@ -8,6 +10,8 @@ namespace GPEngineFixes::Patches
         void __declspec(naked) ApplyTrapDamageHook()
         {
             __asm {
+                inc dword ptr[g_hookCalls + 4 * 4]     // kPatch_ApplyTrapDamage
+
                 test eax, eax           // Check if GetNiNode returned NULL
                 jnz node_valid          // If not null, continue normally
 
@@ -25,27 +29,39 @@ namespace GPEngineFixes::Patches
             }
         }
 
-        void Install()
+        // fld dword ptr [eax+88h]
+        const UInt8 kExpected[] = { 0xD9, 0x80, 0x88, 0x00, 0x00, 0x00 };
+
+        void Register()
         {
-            WriteRelJump(0x005ED1F8, (UInt32)&ApplyTrapDamageHook);
-            _MESSAGE("Actor::ApplyTrapDamage hook installed");
+            using namespace MediumArmor::HookControl;
+            MediumArmor::PatchManifest::Add({ GetName(kPatch_ApplyTrapDamage), kPatch_ApplyTrapDamage,
+                0x005ED1F8, kExpected, sizeof(kExpected), sizeof(kExpected),
+                (UInt32)&ApplyTrapDamageHook, 0,
+                MediumArmor::PatchManifest::kGroup_EngineFixes, false, true, nullptr });
         }
     }
 
     namespace GetDamageFix
     {
+        // Mid-function: the x87 stack and the caller's registers are in an
+        // unknown state here, so the stub calls nothing.
         void __declspec(naked) GetDamageHook()
         {
             __asm {
+                inc dword ptr[g_hookCalls + 4 * 5]     // kPatch_GetDamage
+
                 // EDI contains the weapon pointer at this point
                 test edi, edi           // Check if NULL
                 jz no_weapon_equipped   // Jump if no weapon
 
-                // Original instruction
+                weapon_valid :
+                // Original instructions under the 5-byte jmp
                 mov al, [edi + 4]         // Get form type byte
+                cmp al, 21h               // kFormType_Weapon
 
-                // Return to next instruction (0x484F9C)
-                push 0x00484F9C
+                // Return to next instruction (0x484F9E); push/ret keep the flags
+                push 0x00484F9E
                 ret
 
                 no_weapon_equipped :
@@ -59,18 +75,24 @@ namespace GPEngineFixes::Patches
             }
         }
 
-        void Install()
+        // mov al,[edi+4] ; cmp al,21h - both instructions the jmp overwrites,
+        // so a different build is refused rather than half-patched.
+        const UInt8 kExpected[] = { 0x8A, 0x47, 0x04, 0x3C, 0x21 };
+
+        void Register()
         {
-            WriteRelJump(0x00484F99, (UInt32)&GetDamageHook);
-            _MESSAGE("EquippedWeaponData::GetDamage hook installed");
+            using namespace MediumArmor::HookControl;
+            MediumArmor::PatchManifest::Add({ GetName(kPatch_GetDamage), kPatch_GetDamage,
+                0x00484F99, kExpected, sizeof(kExpected), sizeof(kExpected),
+                (UInt32)&GetDamageHook, 0,
+                MediumArmor::PatchManifest::kGroup_EngineFixes, false, true, nullptr });
         }
 
     }
 
-	void Install()
+	void Register()
 	{
-        ApplyTrapDamageFix::Install();
-        GetDamageFix::Install();
-        _MESSAGE("All hooks installed");
+        ApplyTrapDamageFix::Register();
+        GetDamageFix::Register();
 	}
 }
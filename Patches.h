@@ -2,5 +2,6 @@
 
 namespace GPEngineFixes::Patches
 {
-	void Install();
+	// Adds the engine fixes to MediumArmor::PatchManifest.
+	void Register();
 }
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+// ============================================================================
+//  MediumArmor OBSE Plugin - Progression.h
+//
+//  The skill arithmetic, apart from the active tables and settings: the XP
+//  advance AwardXP applies and the effective skill CalcMediumPieceAR hands
+//  to Calc_ArmorRating.  The plugin calls these with the active level-cost
+//  table and the Config.h constants; tools/BalanceSim calls them with each
+//  grid point's table and parameters.
+//
+//  Platform-neutral; tools/BalanceSim and tools/BattleBench build it as is.
+// ============================================================================
+
+#include "SkillCurve.h"
+
+#include <algorithm>
+
+namespace MediumArmor::Progression
+{
+	// Skill after earning `xp` at `skill`: xp / cost points, clamped to 0..100.
+	inline float Advance(const SkillCurve::Table& levelCost, float skill, float xp)
+	{
+		return std::clamp(skill + xp / SkillCurve::Sample(levelCost, skill), 0.0f, 100.0f);
+	}
+
+	inline float EffectiveSkill(float skill, float multiplier, float flat)
+	{
+		return std::clamp(skill * multiplier + flat, 0.0f, 100.0f);
+	}
+
+	// Inverse of EffectiveSkill for a value read back from the UI; the
+	// caller rules out a zero multiplier.
+	inline float BaseSkill(float effective, float multiplier, float flat)
+	{
+		return std::clamp((effective - flat) / multiplier, 0.0f, 100.0f);
+	}
+}
@@ -0,0 +1,82 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - Settings.cpp
+//
+//  [XPGain]                       [LevelCost]
+//  Curve=0:linear:1.0:-0.005      Curve=0:pow:0.5:0.5
+//  Floor=0.05                     Floor=0.1
+//
+//  [MenuQue]
+//  SkillTile=StatsMenu\...\user20   (tile path for SetMenuFloatValue)
+//  MenuType=1003
+//
+//  [WarmUp]
+//  Enabled=1
+//  BudgetUs=500                     (wear count time per frame)
+//  QueueDepth=128                   (actors queued per cell, at most 512)
+//
+//  [Metrics]
+//  SharedMemory=1                   (publish counters in Local\MediumArmorMetrics)
+//
+//  Curve syntax is documented in SkillCurve.h.  Missing keys keep the
+//  compiled-in defaults.
+// ============================================================================
+
+#include "Settings.h"
+#include "Config.h"
+#include "SkillCurve.h"
+#include "SkillSync.h"
+#include "WarmUp.h"
+#include "MetricsPage.h"
+
+#include <cstdlib>
+#include <windows.h>
+
+namespace MediumArmor::Settings
+{
+
+    static float ReadFloat(const char* section, const char* key, float fallback)
+    {
+        char buf[64];
+        if (!GetPrivateProfileStringA(section, key, "", buf, sizeof(buf), kSettingsPath) || !buf[0])
+            return fallback;
+        return std::strtof(buf, nullptr);
+    }
+
+    static void LoadCurve(const char* section, float defaultFloor,
+        bool (*apply)(const SkillCurve::CurveDef&))
+    {
+        char text[512];
+        if (!GetPrivateProfileStringA(section, "Curve", "", text, sizeof(text), kSettingsPath) || !text[0])
+            return;
+
+        SkillCurve::CurveDef def;
+        const float floor = ReadFloat(section, "Floor", defaultFloor);
+        if (!SkillCurve::Parse(text, floor, def) || !apply(def))
+        {
+            _ERROR("MediumArmor: [%s] Curve=%s is invalid - keeping default.", section, text);
+            return;
+        }
+
+        _MESSAGE("MediumArmor: [%s] curve loaded (%u segments, floor %.3f).", section, def.count, floor);
+    }
+
+    void Load()
+    {
+        LoadCurve("XPGain", 0.0f, &SkillCurve::SetXPGainCurve);
+        LoadCurve("LevelCost", 0.01f, &SkillCurve::SetLevelCostCurve);
+
+        char tile[256];
+        GetPrivateProfileStringA("MenuQue", "SkillTile", "", tile, sizeof(tile), kSettingsPath);
+        const UInt32 menuType = GetPrivateProfileIntA("MenuQue", "MenuType", 1003, kSettingsPath);
+        SkillSync::SetUITile(tile, menuType);
+
+        WarmUp::Configure(
+            GetPrivateProfileIntA("WarmUp", "Enabled", 1, kSettingsPath) != 0,
+            GetPrivateProfileIntA("WarmUp", "BudgetUs", 500, kSettingsPath),
+            GetPrivateProfileIntA("WarmUp", "QueueDepth", 128, kSettingsPath));
+
+        if (GetPrivateProfileIntA("Metrics", "SharedMemory", 1, kSettingsPath))
+            MetricsPage::Start();
+    }
+
+}
@@ -0,0 +1,10 @@
+#pragma once
+// ============================================================================
+//  MediumArmor OBSE Plugin - Settings.h
+//  Optional overrides read from Data\OBSE\Plugins\MediumArmor.ini at load.
+// ============================================================================
+
+namespace MediumArmor::Settings
+{
+	void Load();
+}
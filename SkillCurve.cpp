@@ -0,0 +1,165 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - SkillCurve.cpp
+// ============================================================================
+
+#include "SkillCurve.h"
+#include "Progression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace MediumArmor::SkillCurve
+{
+
+    static Table s_xpGain = kDefaultXPGain;
+    static Table s_levelCost = kDefaultLevelCost;
+
+    float Evaluate(const CurveDef& def, float skill)
+    {
+        if (def.count == 0)
+            return def.floor;
+
+        const Segment* seg = &def.segments[0];
+        for (uint32_t i = 1; i < def.count; ++i)
+        {
+            if (skill < def.segments[i].fromSkill)
+                break;
+            seg = &def.segments[i];
+        }
+
+        float value = 0.0f;
+        switch (seg->shape)
+        {
+        case Shape::Linear:      value = seg->a + seg->b * skill;              break;
+        case Shape::Exponential: value = seg->a * std::exp(seg->b * skill);    break;
+        case Shape::Power:       value = seg->a * std::pow(skill, seg->b);     break;
+        }
+
+        if (!std::isfinite(value))
+            return def.floor;
+        return value > def.floor ? value : def.floor;
+    }
+
+    bool Compile(const CurveDef& def, Table& out)
+    {
+        if (def.count == 0 || def.count > kMaxSegments || def.segments[0].fromSkill != 0.0f)
+            return false;
+
+        for (uint32_t i = 1; i < def.count; ++i)
+        {
+            if (def.segments[i].fromSkill <= def.segments[i - 1].fromSkill)
+                return false;
+        }
+
+        for (uint32_t i = 0; i < kTableSize; ++i)
+            out.v[i] = Evaluate(def, static_cast<float>(i));
+        return true;
+    }
+
+    static bool ParseShape(const char* token, size_t len, Shape& out)
+    {
+        if (len == 6 && std::strncmp(token, "linear", 6) == 0) { out = Shape::Linear; return true; }
+        if (len == 3 && std::strncmp(token, "exp", 3) == 0)    { out = Shape::Exponential; return true; }
+        if (len == 3 && std::strncmp(token, "pow", 3) == 0)    { out = Shape::Power; return true; }
+        return false;
+    }
+
+    static const char* SkipSpaces(const char* p)
+    {
+        while (*p == ' ' || *p == '\t')
+            ++p;
+        return p;
+    }
+
+    bool Parse(const char* text, float floor, CurveDef& out)
+    {
+        out = {};
+        out.floor = floor;
+        if (!text)
+            return false;
+
+        const char* p = SkipSpaces(text);
+        while (*p)
+        {
+            if (out.count == kMaxSegments)
+                return false;
+
+            Segment& seg = out.segments[out.count];
+            char* end = nullptr;
+
+            seg.fromSkill = std::strtof(p, &end);
+            if (end == p || *end != ':')
+                return false;
+
+            p = end + 1;
+            const char* shapeEnd = std::strchr(p, ':');
+            if (!shapeEnd || !ParseShape(p, static_cast<size_t>(shapeEnd - p), seg.shape))
+                return false;
+
+            p = shapeEnd + 1;
+            seg.a = std::strtof(p, &end);
+            if (end == p || *end != ':')
+                return false;
+
+            p = end + 1;
+            seg.b = std::strtof(p, &end);
+            if (end == p)
+                return false;
+
+            ++out.count;
+            p = SkipSpaces(end);
+            if (*p == ';')
+                p = SkipSpaces(p + 1);
+            else if (*p)
+                return false;
+        }
+
+        return out.count > 0;
+    }
+
+    float XPGain(float skill)
+    {
+        return Sample(s_xpGain, skill);
+    }
+
+    float LevelCost(float skill)
+    {
+        return Sample(s_levelCost, skill);
+    }
+
+    float Advance(float skill, float xp)
+    {
+        return Progression::Advance(s_levelCost, skill, xp);
+    }
+
+    bool SetXPGainCurve(const CurveDef& def)
+    {
+        return Compile(def, s_xpGain);
+    }
+
+    bool SetLevelCostCurve(const CurveDef& def)
+    {
+        // A zero cost would make Advance divide by zero.
+        Table table;
+        if (!Compile(def, table))
+            return false;
+
+        for (float v : table.v)
+        {
+            if (v <= 0.0f)
+                return false;
+        }
+
+        s_levelCost = table;
+        return true;
+    }
+
+    void ResetCurves()
+    {
+        s_xpGain = kDefaultXPGain;
+        s_levelCost = kDefaultLevelCost;
+    }
+
+}
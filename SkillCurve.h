@@ -0,0 +1,111 @@
+#pragma once
+// ============================================================================
+//  MediumArmor OBSE Plugin - SkillCurve.h
+//
+//  Skill progression curves compiled to dense lookup tables.  A curve is a
+//  list of segments over skill 0-100; each segment is linear (a + b*s),
+//  exponential (a * e^(b*s)) or power (a * s^b) from its start skill up to
+//  the next segment.  Compiling samples it once per skill point, so a query
+//  is a clamp, one multiply and a lerp - no pow/exp per hit.  Segments
+//  should meet continuously; a jump is smeared over the step before it.
+//
+//  Two curves drive progression:
+//      XP gain    - XP awarded per hit at a given skill.
+//      Level cost - XP needed per skill point at a given skill (the vanilla
+//                   skill-use threshold); Advance() adds xp / cost.
+//
+//  The defaults reproduce the Config.h constants and are built at compile
+//  time.  No OBSE or Windows dependencies.
+// ============================================================================
+
+#include "Config.h"
+
+#include <cstdint>
+
+namespace MediumArmor::SkillCurve
+{
+	constexpr uint32_t kTableSize = 101;    // one sample per skill point, 0..100
+	constexpr uint32_t kMaxSegments = 8;
+
+	enum class Shape : uint8_t
+	{
+		Linear,
+		Exponential,
+		Power,
+	};
+
+	struct Segment
+	{
+		float fromSkill;
+		Shape shape;
+		float a;
+		float b;
+	};
+
+	struct CurveDef
+	{
+		Segment  segments[kMaxSegments];
+		uint32_t count;
+		float    floor;      // results are clamped to at least this
+	};
+
+	struct Table
+	{
+		float v[kTableSize];
+	};
+
+	constexpr float Sample(const Table& table, float skill)
+	{
+		if (!(skill > 0.0f))
+			return table.v[0];
+		if (skill >= static_cast<float>(kTableSize - 1))
+			return table.v[kTableSize - 1];
+
+		const uint32_t i = static_cast<uint32_t>(skill);
+		const float t = skill - static_cast<float>(i);
+		return table.v[i] + (table.v[i + 1] - table.v[i]) * t;
+	}
+
+	constexpr Table MakeDefaultXPGainTable()
+	{
+		Table table = {};
+		for (uint32_t i = 0; i < kTableSize; ++i)
+		{
+			const float factor = 1.0f - kXPSkillFactor * (static_cast<float>(i) / 100.0f);
+			table.v[i] = kXPPerHit * (factor > 0.05f ? factor : 0.05f);
+		}
+		return table;
+	}
+
+	constexpr Table MakeDefaultLevelCostTable()
+	{
+		Table table = {};
+		for (uint32_t i = 0; i < kTableSize; ++i)
+			table.v[i] = 1.0f;
+		return table;
+	}
+
+	inline constexpr Table kDefaultXPGain = MakeDefaultXPGainTable();
+	inline constexpr Table kDefaultLevelCost = MakeDefaultLevelCostTable();
+
+	// Exact (slow) evaluation of a definition; used to compile tables.
+	float Evaluate(const CurveDef& def, float skill);
+
+	bool  Compile(const CurveDef& def, Table& out);
+
+	// Parses "from:shape:a:b; from:shape:a:b ..." where shape is linear,
+	// exp or pow.  Segments must start at 0 and ascend.
+	bool  Parse(const char* text, float floor, CurveDef& out);
+
+	// ── Active tables ──────────────────────────────────────────────────────
+	float XPGain(float skill);
+	float LevelCost(float skill);
+
+	// Skill after earning `xp` at `skill`: xp / LevelCost(skill) points,
+	// clamped to 0..100.
+	float Advance(float skill, float xp);
+
+	bool  SetXPGainCurve(const CurveDef& def);
+	bool  SetLevelCostCurve(const CurveDef& def);
+	void  ResetCurves();
+}
@@ -0,0 +1,111 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - SkillSync.cpp
+// ============================================================================
+
+#include "SkillSync.h"
+#include "FrameClock.h"
+
+#include "obse/PluginAPI.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace MediumArmor::SkillSync
+{
+
+    // Pushes through OBSE's SetMenuFloatValue so a MenuQue/XML tile can show
+    // the value.  There is no read-back channel through the console, so
+    // Pull() reports failure and the plugin's own value stays authoritative.
+    class MenuQueBackend : public UIBackend
+    {
+    public:
+        void Configure(const OBSEConsoleInterface* console, const char* tilePath, uint32_t menuType)
+        {
+            m_console = console;
+            std::snprintf(m_tilePath, sizeof(m_tilePath), "%s", tilePath ? tilePath : "");
+            m_menuType = menuType;
+        }
+
+        bool IsUsable() const
+        {
+            return m_console && m_console->RunScriptLine && m_tilePath[0];
+        }
+
+        void Push(float effectiveSkill) override
+        {
+            if (!IsUsable())
+                return;
+
+            char line[384];
+            std::snprintf(line, sizeof(line), "SetMenuFloatValue \"%s\" %u %.2f",
+                m_tilePath, m_menuType, effectiveSkill);
+            m_console->RunScriptLine(line, nullptr);
+        }
+
+        bool Pull(float&) override
+        {
+            return false;
+        }
+
+    private:
+        const OBSEConsoleInterface* m_console = nullptr;
+        char                        m_tilePath[256] = {};
+        uint32_t                    m_menuType = 0;
+    };
+
+    static MenuQueBackend s_backend;
+    static Syncer         s_syncer;
+    static bool           s_listening = false;
+
+    // The only caller of Flush: a main-thread timer frame, outside every
+    // hook, so RunScriptLine never nests inside engine code.
+    static void OnFrame(uint32_t frame)
+    {
+        s_syncer.Flush(frame);
+    }
+
+    static const OBSEConsoleInterface* s_console = nullptr;
+    static char     s_tilePath[256] = {};
+    static uint32_t s_menuType = 0;
+
+    static void Rebind()
+    {
+        s_backend.Configure(s_console, s_tilePath, s_menuType);
+        s_syncer.SetBackend(s_backend.IsUsable() ? &s_backend : nullptr);
+    }
+
+    void Init(const OBSEConsoleInterface* console)
+    {
+        s_console = console;
+        Rebind();
+
+        if (!s_listening)
+            s_listening = FrameClock::AddListener(&OnFrame);
+
+        if (s_backend.IsUsable())
+            _MESSAGE("MediumArmor: MenuQue skill sync -> \"%s\" (menu %u).", s_tilePath, s_menuType);
+    }
+
+    void SetUITile(const char* tilePath, uint32_t menuType)
+    {
+        std::snprintf(s_tilePath, sizeof(s_tilePath), "%s", tilePath ? tilePath : "");
+        s_menuType = menuType;
+        Rebind();
+    }
+
+    void NotifySkillChanged(float effectiveSkill)
+    {
+        s_syncer.NotifyChanged(effectiveSkill, FrameClock::Current());
+    }
+
+    bool PullFromUI(float& outSkill)
+    {
+        return s_syncer.Pull(outSkill);
+    }
+
+    const Syncer& Get()
+    {
+        return s_syncer;
+    }
+
+}
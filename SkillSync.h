@@ -0,0 +1,123 @@
+#pragma once
+// ============================================================================
+//  MediumArmor OBSE Plugin - SkillSync.h
+//
+//  Change-driven skill sync with the MenuQue UI.  Skill changes only mark
+//  the syncer dirty and bump its version; the value is pushed on the first
+//  frame after the one it changed in, so any number of changes within a
+//  frame cost one UI update, and an unchanged effective skill costs none.
+//  Pulling from the UI happens only on explicit load / menu-open calls.
+//
+//  NotifyChanged is safe anywhere, hook callouts included: it only records.
+//  Flush runs the backend (a console script line) and is called from the
+//  FrameClock timer listener alone, so a single change goes out on the next
+//  timer frame without any further change or command to carry it.
+//
+//  Syncer and UIBackend are engine-independent; SkillSync.cpp binds them to
+//  the game (MenuQue backend, FrameClock, SetMediumArmorSkill).
+//  tools/SkillSyncCheck drives a Syncer against a counting backend.
+// ============================================================================
+
+#include <cstdint>
+
+struct OBSEConsoleInterface;
+
+namespace MediumArmor::SkillSync
+{
+	class UIBackend
+	{
+	public:
+		virtual ~UIBackend() = default;
+
+		virtual void Push(float effectiveSkill) = 0;
+		virtual bool Pull(float& outSkill) = 0;
+	};
+
+	class Syncer
+	{
+	public:
+		explicit Syncer(UIBackend* backend = nullptr) : m_backend(backend) {}
+
+		void SetBackend(UIBackend* backend)
+		{
+			m_backend = backend;
+			m_hasPushed = false;
+			m_dirty = true;
+		}
+
+		void NotifyChanged(float effectiveSkill, uint32_t frame)
+		{
+			if (m_hasValue && effectiveSkill == m_value)
+				return;
+
+			m_value = effectiveSkill;
+			m_hasValue = true;
+			++m_version;
+
+			const bool differsFromUI = !m_hasPushed || m_value != m_pushed;
+			if (differsFromUI && !m_dirty)
+				m_dirtyFrame = frame;
+			m_dirty = differsFromUI;
+		}
+
+		// Once per frame from the driver.  Returns true if an update was
+		// pushed.
+		bool Flush(uint32_t frame)
+		{
+			if (!m_dirty || !m_backend || !m_hasValue || frame == m_dirtyFrame)
+				return false;
+
+			m_backend->Push(m_value);
+			m_pushed = m_value;
+			m_hasPushed = true;
+			m_dirty = false;
+			++m_pushCount;
+			return true;
+		}
+
+		// Explicit pull (game load, menu open).  The pulled value is what the
+		// UI already shows, so it is adopted without a push back.
+		bool Pull(float& outSkill)
+		{
+			if (!m_backend || !m_backend->Pull(outSkill))
+				return false;
+
+			m_value = outSkill;
+			m_pushed = outSkill;
+			m_hasValue = true;
+			m_hasPushed = true;
+			m_dirty = false;
+			++m_version;
+			++m_pullCount;
+			return true;
+		}
+
+		uint32_t GetVersion() const   { return m_version; }
+		uint32_t GetPushCount() const { return m_pushCount; }
+		uint32_t GetPullCount() const { return m_pullCount; }
+		bool     IsDirty() const      { return m_dirty; }
+
+	private:
+		UIBackend* m_backend;
+		float      m_value = 0.0f;
+		float      m_pushed = 0.0f;
+		bool       m_hasValue = false;
+		bool       m_hasPushed = false;
+		bool       m_dirty = false;
+		uint32_t   m_dirtyFrame = 0;
+		uint32_t   m_version = 0;
+		uint32_t   m_pushCount = 0;
+		uint32_t   m_pullCount = 0;
+	};
+
+	// ── Game binding ───────────────────────────────────────────────────────
+	void    Init(const OBSEConsoleInterface* console);
+
+	// Tile the MenuQue UI reads the skill from; empty disables pushing.
+	void    SetUITile(const char* tilePath, uint32_t menuType);
+
+	void    NotifySkillChanged(float effectiveSkill);
+	bool    PullFromUI(float& outSkill);
+
+	const Syncer& Get();
+}
@@ -0,0 +1,286 @@
+#pragma once
+// ============================================================================
+//  MediumArmor OBSE Plugin - SlabPool.h
+//
+//  Fixed-size record pool for per-actor plugin state.  Records live in slabs
+//  of SlabRecords allocated on first use and kept until Reset(), so cell
+//  load/unload churn reuses the same memory instead of hitting the heap.
+//
+//  Callers hold a Handle (slot index + generation), never a pointer across
+//  frames.  Free() bumps the slot's generation, so a handle that outlives its
+//  record resolves to nullptr instead of to whatever reused the slot.
+//
+//  Every record carries an owner tag (the actor's parent cell).  ReleaseTag()
+//  and ReleaseAllExcept() reclaim a detached cell's records in one sweep;
+//  ReleaseOrRetag() lets the caller move some of them to a new owner first.
+//
+//  Platform-neutral; the Linux tools build it as is.
+// ============================================================================
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace MediumArmor
+{
+	struct SlabPoolStats
+	{
+		uint32_t live;
+		uint32_t peak;
+		uint32_t slabs;
+		uint32_t allocs;
+		uint32_t frees;
+		uint32_t failedAllocs;  // every slab in use
+		uint32_t staleLookups;  // Get() with a handle whose record is gone
+		uint32_t bulkReleased;  // records reclaimed by ReleaseTag/ReleaseAllExcept
+	};
+
+	template <typename T, uint32_t SlabRecords = 64, uint32_t MaxSlabs = 64>
+	class SlabPool
+	{
+	public:
+		// Low 16 bits: slot index.  High 16 bits: generation, never 0, so a
+		// zero handle is always null.
+		struct Handle
+		{
+			uint32_t bits;
+
+			bool IsNull() const { return bits == 0; }
+			bool operator==(const Handle& other) const { return bits == other.bits; }
+			bool operator!=(const Handle& other) const { return bits != other.bits; }
+		};
+
+		static constexpr uint32_t kCapacity = SlabRecords * MaxSlabs;
+		static_assert(kCapacity <= 0x10000, "slot index must fit in 16 bits");
+
+		SlabPool() = default;
+		~SlabPool() { Reset(); }
+
+		SlabPool(const SlabPool&) = delete;
+		SlabPool& operator=(const SlabPool&) = delete;
+
+		// Constructs a T in a free slot.  Null handle if the pool is full.
+		template <typename... Args>
+		Handle Alloc(uintptr_t tag, Args&&... args)
+		{
+			if (m_freeHead == kNoSlot && !GrowSlab())
+			{
+				++m_stats.failedAllocs;
+				return Handle{ 0 };
+			}
+
+			const uint32_t index = m_freeHead;
+			Slot& slot = SlotAt(index);
+			m_freeHead = slot.nextFree;
+
+			new (slot.storage) T(std::forward<Args>(args)...);
+			slot.tag = tag;
+			slot.live = true;
+
+			++m_stats.allocs;
+			if (++m_stats.live > m_stats.peak)
+				m_stats.peak = m_stats.live;
+
+			return Handle{ (static_cast<uint32_t>(slot.generation) << 16) | index };
+		}
+
+		T* Get(Handle handle)
+		{
+			Slot* slot = Resolve(handle);
+			if (!slot)
+			{
+				if (!handle.IsNull())
+					++m_stats.staleLookups;
+				return nullptr;
+			}
+			return Value(*slot);
+		}
+
+		bool Free(Handle handle)
+		{
+			Slot* slot = Resolve(handle);
+			if (!slot)
+				return false;
+
+			Release(*slot, handle.bits & 0xFFFF);
+			return true;
+		}
+
+		// Moves a record to another owner (the actor walked into another cell).
+		bool Retag(Handle handle, uintptr_t tag)
+		{
+			Slot* slot = Resolve(handle);
+			if (!slot)
+				return false;
+
+			slot->tag = tag;
+			return true;
+		}
+
+		uint32_t ReleaseTag(uintptr_t tag)
+		{
+			const uint32_t released = Sweep([tag](uintptr_t t) { return t == tag; });
+			m_stats.bulkReleased += released;
+			return released;
+		}
+
+		uint32_t ReleaseAllExcept(uintptr_t tag)
+		{
+			const uint32_t released = Sweep([tag](uintptr_t t) { return t != tag; });
+			m_stats.bulkReleased += released;
+			return released;
+		}
+
+		// owner(tag, record) returns the tag to keep the record under - its
+		// own, or a new one - or 0 to release it.
+		template <typename Fn>
+		uint32_t ReleaseOrRetag(Fn&& owner)
+		{
+			uint32_t released = 0;
+			for (uint32_t s = 0; s < m_slabCount; ++s)
+			{
+				for (uint32_t i = 0; i < SlabRecords; ++i)
+				{
+					Slot& slot = m_slabs[s]->slots[i];
+					if (!slot.live)
+						continue;
+
+					const uintptr_t tag = owner(slot.tag, *Value(slot));
+					if (tag)
+					{
+						slot.tag = tag;
+						continue;
+					}
+
+					Release(slot, s * SlabRecords + i);
+					++released;
+				}
+			}
+
+			m_stats.bulkReleased += released;
+			return released;
+		}
+
+		// Destroys every record and hands the slabs back to the heap.
+		void Reset()
+		{
+			Sweep([](uintptr_t) { return true; });
+			for (uint32_t i = 0; i < m_slabCount; ++i)
+			{
+				delete m_slabs[i];
+				m_slabs[i] = nullptr;
+			}
+			m_slabCount = 0;
+			m_freeHead = kNoSlot;
+			m_stats.slabs = 0;
+		}
+
+		const SlabPoolStats& GetStats() const { return m_stats; }
+
+	private:
+		static constexpr uint32_t kNoSlot = 0xFFFFFFFF;
+
+		// Header first: the generation check and the record's leading fields
+		// share a cache line.
+		struct Slot
+		{
+			uintptr_t tag;
+			uint32_t  nextFree;
+			uint16_t  generation;
+			bool      live;
+			alignas(T) unsigned char storage[sizeof(T)];
+		};
+
+		struct Slab
+		{
+			Slot slots[SlabRecords];
+		};
+
+		Slot& SlotAt(uint32_t index)
+		{
+			return m_slabs[index / SlabRecords]->slots[index % SlabRecords];
+		}
+
+		static T* Value(Slot& slot)
+		{
+			return std::launder(reinterpret_cast<T*>(slot.storage));
+		}
+
+		Slot* Resolve(Handle handle)
+		{
+			const uint32_t index = handle.bits & 0xFFFF;
+			const uint32_t generation = handle.bits >> 16;
+			if (handle.IsNull() || index >= m_slabCount * SlabRecords)
+				return nullptr;
+
+			Slot& slot = SlotAt(index);
+			return slot.live && slot.generation == generation ? &slot : nullptr;
+		}
+
+		bool GrowSlab()
+		{
+			if (m_slabCount == MaxSlabs)
+				return false;
+
+			Slab* slab = new (std::nothrow) Slab;
+			if (!slab)
+				return false;
+
+			// Thread the new slots onto the free list in index order.
+			const uint32_t base = m_slabCount * SlabRecords;
+			for (uint32_t i = 0; i < SlabRecords; ++i)
+			{
+				Slot& slot = slab->slots[i];
+				slot.tag = 0;
+				slot.generation = 1;
+				slot.live = false;
+				slot.nextFree = i + 1 < SlabRecords ? base + i + 1 : m_freeHead;
+			}
+
+			m_slabs[m_slabCount++] = slab;
+			m_freeHead = base;
+			++m_stats.slabs;
+			return true;
+		}
+
+		void Release(Slot& slot, uint32_t index)
+		{
+			Value(slot)->~T();
+			slot.live = false;
+			if (++slot.generation == 0)
+				slot.generation = 1;
+
+			slot.nextFree = m_freeHead;
+			m_freeHead = index;
+
+			++m_stats.frees;
+			--m_stats.live;
+		}
+
+		template <typename Pred>
+		uint32_t Sweep(Pred matches)
+		{
+			uint32_t released = 0;
+			for (uint32_t s = 0; s < m_slabCount; ++s)
+			{
+				for (uint32_t i = 0; i < SlabRecords; ++i)
+				{
+					Slot& slot = m_slabs[s]->slots[i];
+					if (slot.live && matches(slot.tag))
+					{
+						Release(slot, s * SlabRecords + i);
+						++released;
+					}
+				}
+			}
+
+			return released;
+		}
+
+		Slab*         m_slabs[MaxSlabs] = {};
+		uint32_t      m_slabCount = 0;
+		uint32_t      m_freeHead = kNoSlot;
+		SlabPoolStats m_stats = {};
+	};
+}
@@ -0,0 +1,80 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - TierIndex.cpp
+// ============================================================================
+
+#include "TierIndex.h"
+#include "MediumArmor.h"
+#include "Timing.h"
+
+#include "obse/GameAPI.h"
+#include "obse/GameForms.h"
+#include "obse/GameObjects.h"
+#include "obse/GameData.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace MediumArmor::TierIndex
+{
+
+    static std::vector<UInt32> s_tiers[kTier_Count];
+    static bool                s_built = false;
+
+    Tier TierOf(TESForm* armorForm)
+    {
+        return IsMediumArmor(armorForm) ? kTier_Medium
+            : HasHeavyFlag(armorForm) ? kTier_Heavy : kTier_Light;
+    }
+
+    void Build()
+    {
+        const UInt64 start = Timing::NowNs();
+
+        for (std::vector<UInt32>& tier : s_tiers)
+            tier.clear();
+
+        ForEachArmorForm([](TESForm* form)
+            {
+                s_tiers[TierOf(form)].push_back(form->refID);
+            });
+
+        for (std::vector<UInt32>& tier : s_tiers)
+        {
+            std::sort(tier.begin(), tier.end());
+            tier.erase(std::unique(tier.begin(), tier.end()), tier.end());
+        }
+
+        s_built = true;
+        _MESSAGE("MediumArmor: Tier index built in %.2f ms (light %u, medium %u, heavy %u).",
+            (Timing::NowNs() - start) / 1e6, static_cast<UInt32>(s_tiers[kTier_Light].size()),
+            static_cast<UInt32>(s_tiers[kTier_Medium].size()), static_cast<UInt32>(s_tiers[kTier_Heavy].size()));
+    }
+
+    bool IsBuilt()
+    {
+        return s_built;
+    }
+
+    UInt32 Query(UInt32 tier, SInt32 modIndex, const UInt32** outFirst)
+    {
+        *outFirst = nullptr;
+        if (tier >= kTier_Count || modIndex < kAllMods || modIndex > 0xFF)
+            return 0;
+
+        const std::vector<UInt32>& ids = s_tiers[tier];
+        if (modIndex == kAllMods)
+        {
+            *outFirst = ids.data();
+            return static_cast<UInt32>(ids.size());
+        }
+
+        const UInt32 lo = static_cast<UInt32>(modIndex) << 24;
+        auto begin = std::lower_bound(ids.begin(), ids.end(), lo);
+        auto end = modIndex == 0xFF ? ids.end()
+            : std::lower_bound(begin, ids.end(), lo + 0x01000000u);
+
+        *outFirst = ids.data() + (begin - ids.begin());
+        return static_cast<UInt32>(end - begin);
+    }
+
+}
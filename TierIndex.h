@@ -0,0 +1,40 @@
+#pragma once
+// ============================================================================
+//  MediumArmor OBSE Plugin - TierIndex.h
+//
+//  Inverted index from armour tier to the sorted form IDs in that tier,
+//  built once after data load.  Medium comes from the classification
+//  (KeywordAPI / editor-ID keyword); of the rest, forms with the heavy
+//  flag are heavy and everything else light.  Sorted IDs keep each mod's
+//  forms contiguous, so a mod-index filter is a range, not a copy.
+//
+//  Only tiers are indexed.  The medium tier is the set for the one keyword
+//  the plugin classifies by; no other keyword has a set of its own.
+//  CompareMediumArmorIndex times a query against the per-form loop.
+// ============================================================================
+
+class TESForm;
+
+namespace MediumArmor::TierIndex
+{
+	enum Tier : UInt32
+	{
+		kTier_Light = 0,
+		kTier_Medium = 1,
+		kTier_Heavy = 2,
+
+		kTier_Count
+	};
+
+	constexpr SInt32 kAllMods = -1;
+
+	// One armour form's tier, by the same rule the index is built with.
+	Tier   TierOf(TESForm* armorForm);
+
+	void   Build();
+	bool   IsBuilt();
+
+	// Points *outFirst at the tier's IDs (restricted to one mod index unless
+	// kAllMods) and returns how many there are.
+	UInt32 Query(UInt32 tier, SInt32 modIndex, const UInt32** outFirst);
+}
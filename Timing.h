@@ -0,0 +1,17 @@
+#pragma once
+// ============================================================================
+//  MediumArmor OBSE Plugin - Timing.h
+//  Monotonic nanosecond clock (QueryPerformanceCounter under MSVC).
+// ============================================================================
+
+#include <chrono>
+#include <cstdint>
+
+namespace MediumArmor::Timing
+{
+	inline uint64_t NowNs()
+	{
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+}
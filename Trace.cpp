@@ -0,0 +1,195 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - Trace.cpp
+// ============================================================================
+
+#include "Trace.h"
+#include "Timing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+
+namespace MediumArmor::Trace
+{
+
+    struct ThreadBuffer
+    {
+        std::unique_ptr<Event[]> events;
+        uint32_t                 capacity = 0;
+        std::atomic<uint32_t>    count{ 0 };
+        uint32_t                 dropped = 0;
+    };
+
+    static ThreadBuffer           s_buffers[kMaxThreads];
+    static std::atomic<uint32_t>  s_threadsClaimed{ 0 };
+    static std::atomic<uint32_t>  s_session{ 0 };
+    static std::atomic<bool>      s_capturing{ false };
+    static uint64_t               s_startNs = 0;
+
+    // Per-thread slot, revalidated against the capture session so a thread
+    // that recorded in an earlier capture claims a fresh buffer.
+    struct ThreadSlot
+    {
+        uint32_t      session = 0;
+        ThreadBuffer* buffer = nullptr;
+    };
+
+    static thread_local ThreadSlot t_slot;
+
+    // Tail of each buffer kept for 'E' events so every recorded span closes.
+    constexpr uint32_t kEndReserve = 64;
+
+    static ThreadBuffer* ClaimBuffer(uint32_t session)
+    {
+        if (t_slot.session == session)
+            return t_slot.buffer;
+
+        const uint32_t index = s_threadsClaimed.fetch_add(1, std::memory_order_relaxed);
+        t_slot.session = session;
+        t_slot.buffer = index < kMaxThreads ? &s_buffers[index] : nullptr;
+        return t_slot.buffer;
+    }
+
+    bool Start(uint32_t eventsPerThread)
+    {
+        if (s_capturing.load(std::memory_order_acquire) || eventsPerThread <= kEndReserve)
+            return false;
+
+        for (ThreadBuffer& buf : s_buffers)
+        {
+            if (buf.capacity != eventsPerThread)
+            {
+                buf.events.reset(new Event[eventsPerThread]);
+                buf.capacity = eventsPerThread;
+            }
+            buf.count.store(0, std::memory_order_relaxed);
+            buf.dropped = 0;
+        }
+
+        s_threadsClaimed.store(0, std::memory_order_relaxed);
+        s_session.fetch_add(1, std::memory_order_release);
+        s_startNs = Timing::NowNs();
+        s_capturing.store(true, std::memory_order_release);
+        return true;
+    }
+
+    void Stop()
+    {
+        s_capturing.store(false, std::memory_order_release);
+    }
+
+    bool IsCapturing()
+    {
+        return s_capturing.load(std::memory_order_relaxed);
+    }
+
+    static bool Record(ThreadBuffer* buf, const char* name, char phase)
+    {
+        if (!buf)
+            return false;
+
+        const uint32_t index = buf->count.load(std::memory_order_relaxed);
+        const uint32_t limit = phase == 'E' ? buf->capacity : buf->capacity - kEndReserve;
+        if (index >= limit)
+        {
+            ++buf->dropped;
+            return false;
+        }
+
+        buf->events[index] = { name, Timing::NowNs(), phase };
+        buf->count.store(index + 1, std::memory_order_release);
+        return true;
+    }
+
+    uint32_t Begin(const char* name)
+    {
+        if (!s_capturing.load(std::memory_order_relaxed))
+            return 0;
+
+        const uint32_t capture = s_session.load(std::memory_order_acquire);
+        return Record(ClaimBuffer(capture), name, 'B') ? capture : 0;
+    }
+
+    bool End(const char* name, uint32_t capture)
+    {
+        // A later Start() hands this thread a fresh buffer; the 'B' is not
+        // in it, so neither goes the 'E'.
+        if (!s_capturing.load(std::memory_order_relaxed)
+            || s_session.load(std::memory_order_acquire) != capture)
+            return false;
+
+        return Record(ClaimBuffer(capture), name, 'E');
+    }
+
+    uint32_t GetRecordedCount()
+    {
+        uint32_t total = 0;
+        for (const ThreadBuffer& buf : s_buffers)
+            total += buf.count.load(std::memory_order_acquire);
+        return total;
+    }
+
+    uint32_t GetDroppedCount()
+    {
+        uint32_t total = 0;
+        for (const ThreadBuffer& buf : s_buffers)
+            total += buf.dropped;
+        return total;
+    }
+
+    static void WriteEscaped(std::FILE* f, const char* s)
+    {
+        for (; *s; ++s)
+        {
+            const unsigned char c = static_cast<unsigned char>(*s);
+            if (c == '"' || c == '\\')
+                std::fprintf(f, "\\%c", c);
+            else if (c < 0x20)
+                std::fprintf(f, "\\u%04x", c);
+            else
+                std::fputc(c, f);
+        }
+    }
+
+    bool Export(const char* path)
+    {
+        if (IsCapturing() || !path)
+            return false;
+
+        std::FILE* f = std::fopen(path, "w");
+        if (!f)
+            return false;
+
+        std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", f);
+
+        bool first = true;
+        const uint32_t threads = std::min<uint32_t>(s_threadsClaimed.load(), kMaxThreads);
+        for (uint32_t tid = 0; tid < threads; ++tid)
+        {
+            const ThreadBuffer& buf = s_buffers[tid];
+            const uint32_t count = buf.count.load(std::memory_order_acquire);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                const Event& ev = buf.events[i];
+                const uint64_t rel = ev.ns - s_startNs;
+
+                std::fputs(first ? "\n" : ",\n", f);
+                first = false;
+
+                // ts is in microseconds; keep nanosecond precision in the fraction.
+                std::fputs("{\"name\":\"", f);
+                WriteEscaped(f, ev.name);
+                std::fprintf(f, "\",\"cat\":\"MediumArmor\",\"ph\":\"%c\",\"ts\":%llu.%03u,\"pid\":1,\"tid\":%u}",
+                    ev.phase,
+                    static_cast<unsigned long long>(rel / 1000),
+                    static_cast<unsigned>(rel % 1000),
+                    tid);
+            }
+        }
+
+        std::fputs("\n]}\n", f);
+        return std::fclose(f) == 0;
+    }
+
+}
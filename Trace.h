@@ -0,0 +1,75 @@
+#pragma once
+// ============================================================================
+//  MediumArmor OBSE Plugin - Trace.h
+//  Optional span tracer for detours, command handlers and inventory scans.
+//
+//  Start() allocates one fixed buffer per recording thread; after that,
+//  recording is allocation-free and events past a full buffer are dropped.
+//  Stop() ends the capture, Export() writes Chrome trace-event JSON that
+//  loads in Perfetto / chrome://tracing.  No Windows or OBSE dependencies.
+//
+//  Each capture has its own number.  A scope remembers the capture its
+//  'B' went into and only records its 'E' into the same one, so a scope
+//  open across Stop()/Start() leaves no stray 'E' in the next capture.
+//
+//  Naked detours cannot hold a Scope; the hook spans are named after the
+//  C++ callout they time (e.g. "IsHeavyArmor_Classify"), not the detour.
+// ============================================================================
+
+#include <cstdint>
+
+namespace MediumArmor::Trace
+{
+	constexpr uint32_t kMaxThreads = 8;
+	constexpr uint32_t kDefaultEventsPerThread = 1 << 16;
+
+	struct Event
+	{
+		const char* name;   // must be a string literal
+		uint64_t    ns;
+		char        phase;  // 'B' or 'E'
+	};
+
+	bool     Start(uint32_t eventsPerThread = kDefaultEventsPerThread);
+	void     Stop();
+	bool     IsCapturing();
+
+	uint32_t GetRecordedCount();
+	uint32_t GetDroppedCount();
+
+	bool     Export(const char* path);
+
+	// Records a 'B'; returns the capture it went into, or 0 if it was not
+	// recorded (idle or buffer full).
+	uint32_t Begin(const char* name);
+
+	// Records the matching 'E' if `capture` is still the running capture.
+	bool     End(const char* name, uint32_t capture);
+
+	class Scope
+	{
+	public:
+		explicit Scope(const char* name) : m_name(name), m_capture(0)
+		{
+			if (IsCapturing())
+				m_capture = Begin(name);
+		}
+
+		~Scope()
+		{
+			if (m_capture)
+				End(m_name, m_capture);
+		}
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		const char* m_name;
+		uint32_t    m_capture;
+	};
+}
+
+#define MA_TRACE_CONCAT_(a, b) a##b
+#define MA_TRACE_CONCAT(a, b)  MA_TRACE_CONCAT_(a, b)
+#define MA_TRACE_SCOPE(name)   ::MediumArmor::Trace::Scope MA_TRACE_CONCAT(_traceScope, __LINE__)(name)
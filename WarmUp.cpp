@@ -0,0 +1,178 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - WarmUp.cpp
+// ============================================================================
+
+#include "WarmUp.h"
+#include "CellWatch.h"
+#include "FrameClock.h"
+#include "MediumArmor.h"
+#include "Timing.h"
+#include "Trace.h"
+
+#include "obse/GameAPI.h"
+#include "obse/GameForms.h"
+#include "obse/GameObjects.h"
+#include "obse/GameRTTI.h"
+
+#include <algorithm>
+
+namespace MediumArmor::WarmUp
+{
+
+    static bool   s_enabled = true;
+    static UInt32 s_budgetUs = 500;
+    static UInt32 s_queueDepth = 128;
+    static bool   s_initialized = false;
+
+    // Ring of actor refIDs.
+    static UInt32 s_queue[kMaxQueueDepth] = {};
+    static UInt32 s_head = 0;
+    static UInt32 s_count = 0;
+
+    static Stats  s_stats = {};
+
+    static bool Push(UInt32 refID)
+    {
+        if (s_count >= s_queueDepth)
+        {
+            ++s_stats.dropped;
+            return false;
+        }
+
+        s_queue[(s_head + s_count) % kMaxQueueDepth] = refID;
+        ++s_count;
+        ++s_stats.queued;
+        return true;
+    }
+
+    static UInt32 Pop()
+    {
+        const UInt32 refID = s_queue[s_head];
+        s_head = (s_head + 1) % kMaxQueueDepth;
+        --s_count;
+        return refID;
+    }
+
+    // False once the queue is full.
+    static bool QueueCell(TESObjectCELL* cell)
+    {
+        for (TESObjectCELL::ObjectListEntry* entry = &cell->objectList; entry; entry = entry->next)
+        {
+            TESObjectREFR* refr = entry->refr;
+            if (refr && refr->IsActor() && refr != *g_thePlayer && !Push(refr->refID))
+                return false;
+        }
+        return true;
+    }
+
+    // The player's cell first: its actors are the ones met soonest.
+    static void OnLoadedCellsChanged(const CellWatch::Change& change)
+    {
+        if (!s_enabled || !change.attachedCount)
+            return;
+
+        MA_TRACE_SCOPE("WarmUp_QueueCells");
+
+        for (UInt32 i = 0; i < change.attachedCount; ++i)
+        {
+            if (!QueueCell(change.attached[i]))
+                break;
+        }
+    }
+
+    // Resolves a queued refID; null if the reference is gone.
+    static Actor* Resolve(UInt32 refID)
+    {
+        TESForm* form = LookupFormByID(refID);
+        TESObjectREFR* refr = form ? OBLIVION_CAST(form, TESForm, TESObjectREFR) : nullptr;
+        if (!refr || !refr->IsActor() || !refr->parentCell)
+            return nullptr;
+        return static_cast<Actor*>(refr);
+    }
+
+    static void OnFrame(uint32_t frame)
+    {
+        if (!s_enabled || !s_count)
+            return;
+
+        MA_TRACE_SCOPE("WarmUp_Frame");
+
+        const UInt64 start = Timing::NowNs();
+        const UInt64 deadline = start + s_budgetUs * 1000ull;
+
+        do
+        {
+            Actor* actor = Resolve(Pop());
+            if (!actor)
+            {
+                ++s_stats.gone;
+                continue;
+            }
+
+            CountEquippedMediumArmor(actor);
+            ++s_stats.scanned;
+        }
+        while (s_count && Timing::NowNs() < deadline);
+
+        const UInt64 elapsed = Timing::NowNs() - start;
+        ++s_stats.busyFrames;
+        s_stats.totalNs += elapsed;
+        s_stats.maxFrameUs = std::max(s_stats.maxFrameUs, static_cast<UInt32>(elapsed / 1000));
+    }
+
+    void Init()
+    {
+        if (s_initialized)
+            return;
+
+        s_initialized = CellWatch::AddListener(&OnLoadedCellsChanged) &&
+            FrameClock::AddListener(&OnFrame);
+        if (!s_initialized)
+            _ERROR("MediumArmor: warm-up scheduler could not register its listeners.");
+    }
+
+    void Configure(bool enabled, UInt32 budgetUs, UInt32 queueDepth)
+    {
+        Clear();
+        s_enabled = enabled;
+        s_budgetUs = std::max<UInt32>(budgetUs, 1);
+        s_queueDepth = std::clamp<UInt32>(queueDepth, 1, kMaxQueueDepth);
+    }
+
+    bool IsEnabled()
+    {
+        return s_enabled;
+    }
+
+    UInt32 GetBudgetUs()
+    {
+        return s_budgetUs;
+    }
+
+    UInt32 GetQueueDepth()
+    {
+        return s_queueDepth;
+    }
+
+    UInt32 GetPending()
+    {
+        return s_count;
+    }
+
+    void Clear()
+    {
+        s_head = 0;
+        s_count = 0;
+    }
+
+    const Stats& GetStats()
+    {
+        return s_stats;
+    }
+
+    void ResetStats()
+    {
+        s_stats = {};
+    }
+
+}
@@ -0,0 +1,50 @@
+#pragma once
+// ============================================================================
+//  MediumArmor OBSE Plugin - WarmUp.h
+//
+//  Time-sliced wear warm-up for crowded cells.  When cells attach (the
+//  interior behind a load door, the whole exterior grid, or a new row of
+//  it), their actors are queued by refID, the player's cell first; every
+//  plugin frame then counts queued actors' equipped medium armour until the
+//  budget is spent.  The budget is checked between actors; one count is a
+//  single inventory walk and is not split across frames.
+//
+//  What this buys is the published wear table (MediumArmorAPI) filled in
+//  before the first combat round, so other plugins reading it see the
+//  cell's actors straight away.  It does not make combat counts cheaper:
+//  with no equip or container change signal, CountEquippedMediumArmor
+//  still walks the inventory on every call.
+//
+//  Actors are looked up again when their turn comes, so one that unloaded
+//  while queued is dropped rather than dereferenced.
+// ============================================================================
+
+namespace MediumArmor::WarmUp
+{
+	constexpr UInt32 kMaxQueueDepth = 512;
+
+	struct Stats
+	{
+		UInt32 queued;
+		UInt32 dropped;         // queue full
+		UInt32 scanned;
+		UInt32 gone;            // unloaded or no longer an actor
+		UInt32 busyFrames;
+		UInt32 maxFrameUs;
+		UInt64 totalNs;
+	};
+
+	void   Init();
+	void   Configure(bool enabled, UInt32 budgetUs, UInt32 queueDepth);
+
+	bool   IsEnabled();
+	UInt32 GetBudgetUs();
+	UInt32 GetQueueDepth();
+	UInt32 GetPending();
+
+	// LoadGame: drop the queue.
+	void   Clear();
+
+	const Stats& GetStats();
+	void   ResetStats();
+}
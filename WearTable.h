@@ -0,0 +1,42 @@
+#pragma once
+// ============================================================================
+//  MediumArmor OBSE Plugin - WearTable.h
+//
+//  Writes to the wear summaries published through MediumArmorAPI: open
+//  addressing by actor refID over a short probe run, the home slot evicted
+//  when the run is full.  Storage belongs to the caller and never moves.
+//
+//  Platform-neutral; tools/BattleBench builds it as is.
+// ============================================================================
+
+#include "MediumArmorAPI.h"
+
+#include <cstdint>
+
+namespace MediumArmor::WearTable
+{
+	constexpr uint32_t kMaxProbe = 8;
+
+	// `capacity` must be a power of two.
+	inline void Record(MediumArmorWearSummary* slots, uint32_t capacity, uint32_t actorRefID, int mediumCount)
+	{
+		const uint32_t home = (actorRefID * 0x9E3779B1u) & (capacity - 1);
+
+		uint32_t index = home;
+		for (uint32_t i = 0; i < kMaxProbe; ++i)
+		{
+			const uint32_t probe = (home + i) & (capacity - 1);
+			if (slots[probe].actorRefID == actorRefID || slots[probe].actorRefID == 0)
+			{
+				index = probe;
+				break;
+			}
+		}
+
+		// Probe run exhausted: evict the home slot.
+		MediumArmorWearSummary* slot = &slots[index];
+		slot->actorRefID = actorRefID;
+		slot->mediumCount = static_cast<uint16_t>(mediumCount);
+		++slot->stamp;
+	}
+}
@@ -3,6 +3,18 @@
 
 #include "OBSEKeywords/KeywordAPI.h"
 #include "Hooks.h"
+#include "Patches.h"
+#include "PatchManifest.h"
+#include "Commands.h"
+#include "Interface.h"
+#include "MediumArmor.h"
+#include "Settings.h"
+#include "TierIndex.h"
+#include "CellWatch.h"
+#include "WarmUp.h"
+#include "SkillSync.h"
+#include "FrameClock.h"
+#include "ChangeEpochs.h"
 
 #if OBLIVION
 #include "obse/GameAPI.h"
@@ -30,6 +42,9 @@ OBSEMessagingInterface* g_msg;
 
 void UnifiedMessageHandler(OBSEMessagingInterface::Message* msg)
 {
+	if (MediumArmor::Interface::HandleMessage(msg))
+		return;
+
 	KeywordAPI::MessageHandler(msg);
 }
 
@@ -41,7 +56,18 @@ void MessageHandler(OBSEMessagingInterface::Message* msg)
 		g_msg->RegisterListener(g_pluginHandle, nullptr, UnifiedMessageHandler);
 		break;
 	case OBSEMessagingInterface::kMessage_LoadGame:
-		MediumArmor::InstallHooks();
+		if (!MediumArmor::IsClassificationTableBuilt())
+			MediumArmor::BuildClassificationTable();
+		if (!MediumArmor::TierIndex::IsBuilt())
+			MediumArmor::TierIndex::Build();
+		MediumArmor::ClearWearState();
+		MediumArmor::CellWatch::Reset();
+		MediumArmor::WarmUp::Clear();
+		MediumArmor::ChangeEpochs::Clear();
+		MediumArmor::RegisterHooks();
+		GPEngineFixes::Patches::Register();
+		MediumArmor::PatchManifest::Install();
+		MediumArmor::SyncSkillFromMenuQue();
 		break;
 	default:
 		break;
@@ -88,6 +114,16 @@ extern "C" {
 
 		KeywordAPI::Init(g_msg, g_pluginHandle);
 
+		MediumArmor::RegisterCommands(OBSE);
+
+		MediumArmor::Settings::Load();
+		MediumArmor::WarmUp::Init();
+		MediumArmor::ChangeEpochs::Init();
+		MediumArmor::SkillSync::Init(static_cast<OBSEConsoleInterface*>(OBSE->QueryInterface(kInterface_Console)));
+
+		if (!OBSE->isEditor)
+			MediumArmor::FrameClock::Start();
+
 		return true;
 	}
 
@@ -0,0 +1,464 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - tools/BalanceSim.cpp
+//
+//  Monte Carlo balance simulator for the Config.h tuning constants
+//  (kARMultiplier, kARFlat, kXPPerHit, kXPSkillFactor).  For every point of a
+//  parameter grid it runs many simulated characters through a series of
+//  encounters and prints one CSV row: skill percentiles at checkpoints and
+//  the distribution of damage taken per encounter.
+//
+//  XP and the effective skill go through Progression.h, the arithmetic the
+//  plugin's AwardXP and CalcMediumPieceAR call, with each grid point's
+//  compiled tables and parameters in place of the active ones.  AR is then
+//  Calc_ArmorRating per piece, rounded up.  Calc_ArmorRating itself is
+//  approximated below - the plugin only changes its skill argument, so grid
+//  points compare fairly even where the engine constants differ.
+//
+//  Build (Linux):
+//      g++ -O2 -std=c++20 -pthread -include tools/ToolPrefix.h -I.
+//          tools/BalanceSim.cpp SkillCurve.cpp -o balancesim
+//
+//  Usage:
+//      balancesim [--ar-mult A[:B:N]] [--ar-flat A[:B:N]]
+//                 [--xp-per-hit A[:B:N]] [--xp-factor A[:B:N]]
+//                 [--level-cost "from:shape:a:b; ..."] [--runs N]
+//                 [--encounters N] [--hits N] [--checkpoints N]
+//                 [--threads N] [--seed N]
+//
+//  A:B:N sweeps N evenly spaced values from A to B; a single value pins the
+//  parameter.  Rows go to stdout, timing to stderr.  Results depend only on
+//  the seed, not on the thread count.
+// ============================================================================
+
+#include "Config.h"
+#include "Progression.h"
+#include "SkillCurve.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace MediumArmor;
+
+namespace
+{
+    // ── Engine model ───────────────────────────────────────────────────────
+    constexpr float kLuckSkillMult = 0.4f;     // luck points above 50 -> skill
+    constexpr float kSkillScaleMin = 0.5f;     // AR multiplier at skill 0
+    constexpr float kSkillScaleMax = 1.5f;     // AR multiplier at skill 100
+    constexpr float kConditionMin = 0.5f;      // AR multiplier at 0% condition
+    constexpr float kMaxArmorRating = 85.0f;   // damage reduction cap
+
+    // A full medium set: cuirass, greaves, helmet, boots, gauntlets.
+    constexpr UInt16 kPieceBaseAR[] = { 12, 7, 4, 4, 4 };
+
+    constexpr float kStartSkill = 5.0f;        // s_mediumArmorSkill default
+    constexpr float kLuck = 50.0f;
+    constexpr float kHitDamageMin = 10.0f;
+    constexpr float kHitDamageMax = 30.0f;
+
+    constexpr UInt32 kRunsPerTask = 256;
+    constexpr UInt32 kMaxCheckpoints = 16;
+    constexpr UInt32 kSkillBins = 101;
+    constexpr UInt32 kDamageBins = 512;
+    constexpr float  kDamageBinWidth = 1.0f;
+
+    double CalcArmorRating(UInt16 baseAR, float skill, float luck, float condition)
+    {
+        const float luckSkill = std::clamp(skill + (luck - 50.0f) * kLuckSkillMult, 0.0f, 100.0f);
+        const float skillScale = kSkillScaleMin + (kSkillScaleMax - kSkillScaleMin) * luckSkill / 100.0f;
+        const float conditionScale = kConditionMin + (1.0f - kConditionMin) * condition;
+        return baseAR * skillScale * conditionScale;
+    }
+
+    // ── Grid ───────────────────────────────────────────────────────────────
+    struct Range
+    {
+        float  from = 0.0f;
+        float  to = 0.0f;
+        UInt32 steps = 1;
+
+        float At(UInt32 i) const
+        {
+            return steps > 1 ? from + (to - from) * i / (steps - 1) : from;
+        }
+    };
+
+    struct GridPoint
+    {
+        float            arMult;
+        float            arFlat;
+        float            xpPerHit;
+        float            xpFactor;
+        SkillCurve::Table xpGain;
+    };
+
+    struct Options
+    {
+        Range  arMult = { kARMultiplier, kARMultiplier, 1 };
+        Range  arFlat = { kARFlat, kARFlat, 1 };
+        Range  xpPerHit = { kXPPerHit, kXPPerHit, 1 };
+        Range  xpFactor = { kXPSkillFactor, kXPSkillFactor, 1 };
+        const char* levelCost = nullptr;
+        UInt32 runs = 4096;
+        UInt32 encounters = 100;
+        UInt32 hits = 5;
+        UInt32 checkpoints = 5;
+        UInt32 threads = 0;
+        UInt64 seed = 1;
+    };
+
+    // ── Results ────────────────────────────────────────────────────────────
+    struct Histograms
+    {
+        UInt32 skill[kMaxCheckpoints][kSkillBins];
+        UInt32 damage[kDamageBins];
+        double damageSum;
+        UInt64 encounters;
+    };
+
+    // ── RNG: splitmix64 seeding, xorshift64* stream ────────────────────────
+    UInt64 SplitMix(UInt64 x)
+    {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    class Rng
+    {
+    public:
+        explicit Rng(UInt64 seed) : m_state(SplitMix(seed) | 1) {}
+
+        UInt64 Next()
+        {
+            m_state ^= m_state >> 12;
+            m_state ^= m_state << 25;
+            m_state ^= m_state >> 27;
+            return m_state * 0x2545F4914F6CDD1Dull;
+        }
+
+        float Uniform(float lo, float hi)
+        {
+            return lo + (hi - lo) * static_cast<float>(Next() >> 40) * (1.0f / 16777216.0f);
+        }
+
+        UInt32 Below(UInt32 n)
+        {
+            return static_cast<UInt32>((Next() >> 32) * n >> 32);
+        }
+
+    private:
+        UInt64 m_state;
+    };
+
+    // ── Work-stealing pool ─────────────────────────────────────────────────
+    // Tasks are indices.  Each worker drains its own deque from the back and
+    // steals from the front of the others; with no task spawning new work,
+    // every deque empty means done.
+    class WorkStealingPool
+    {
+    public:
+        explicit WorkStealingPool(UInt32 threads) : m_queues(threads) {}
+
+        template <typename Fn>
+        void Run(UInt32 taskCount, Fn&& fn)
+        {
+            const UInt32 workers = static_cast<UInt32>(m_queues.size());
+
+            // Contiguous blocks keep a worker on one grid point while it can.
+            for (UInt32 i = 0; i < taskCount; ++i)
+                m_queues[static_cast<UInt64>(i) * workers / taskCount].tasks.push_back(i);
+
+            std::vector<std::thread> threads;
+            for (UInt32 w = 0; w < workers; ++w)
+            {
+                threads.emplace_back([this, w, &fn]
+                    {
+                        UInt32 task;
+                        while (PopLocal(w, task) || Steal(w, task))
+                            fn(task);
+                    });
+            }
+            for (std::thread& t : threads)
+                t.join();
+        }
+
+        UInt64 GetStealCount() const { return m_steals.load(); }
+
+    private:
+        struct Queue
+        {
+            std::mutex         lock;
+            std::deque<UInt32> tasks;
+        };
+
+        bool PopLocal(UInt32 self, UInt32& task)
+        {
+            Queue& q = m_queues[self];
+            std::lock_guard<std::mutex> guard(q.lock);
+            if (q.tasks.empty())
+                return false;
+            task = q.tasks.back();
+            q.tasks.pop_back();
+            return true;
+        }
+
+        bool Steal(UInt32 self, UInt32& task)
+        {
+            const UInt32 workers = static_cast<UInt32>(m_queues.size());
+            for (UInt32 i = 1; i < workers; ++i)
+            {
+                Queue& q = m_queues[(self + i) % workers];
+                std::lock_guard<std::mutex> guard(q.lock);
+                if (q.tasks.empty())
+                    continue;
+                task = q.tasks.front();
+                q.tasks.pop_front();
+                m_steals.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+            return false;
+        }
+
+        std::vector<Queue>  m_queues;
+        std::atomic<UInt64> m_steals{ 0 };
+    };
+
+    // ── Simulation ─────────────────────────────────────────────────────────
+    float TotalArmorRating(const GridPoint& point, float skill, float condition)
+    {
+        const float effective = Progression::EffectiveSkill(skill, point.arMult, point.arFlat);
+
+        float total = 0.0f;
+        for (UInt16 baseAR : kPieceBaseAR)
+            total += std::ceil(static_cast<float>(CalcArmorRating(baseAR, effective, kLuck, condition)));
+        return std::min(total, kMaxArmorRating);
+    }
+
+    void SimulateRuns(const Options& opt, const GridPoint& point, const SkillCurve::Table& levelCost,
+        const UInt32* checkpointAt, Rng& rng, UInt32 runs, Histograms& out)
+    {
+        for (UInt32 run = 0; run < runs; ++run)
+        {
+            float skill = kStartSkill;
+            const float condition = rng.Uniform(0.5f, 1.0f);
+            UInt32 nextCheckpoint = 0;
+
+            for (UInt32 enc = 1; enc <= opt.encounters; ++enc)
+            {
+                const UInt32 hits = 1 + rng.Below(2 * opt.hits - 1);
+                float taken = 0.0f;
+
+                for (UInt32 h = 0; h < hits; ++h)
+                {
+                    const float ar = TotalArmorRating(point, skill, condition);
+                    taken += rng.Uniform(kHitDamageMin, kHitDamageMax) * (1.0f - ar / 100.0f);
+
+                    // AwardXP(CalculateXPGain(skill))
+                    const float xp = SkillCurve::Sample(point.xpGain, skill);
+                    skill = Progression::Advance(levelCost, skill, xp);
+                }
+
+                const UInt32 bin = std::min(static_cast<UInt32>(taken / kDamageBinWidth), kDamageBins - 1);
+                ++out.damage[bin];
+                out.damageSum += taken;
+                ++out.encounters;
+
+                if (nextCheckpoint < opt.checkpoints && enc == checkpointAt[nextCheckpoint])
+                    ++out.skill[nextCheckpoint++][static_cast<UInt32>(skill)];
+            }
+        }
+    }
+
+    UInt32 Percentile(const UInt32* bins, UInt32 count, double p)
+    {
+        UInt64 total = 0;
+        for (UInt32 i = 0; i < count; ++i)
+            total += bins[i];
+
+        const double target = p * total;
+        UInt64 running = 0;
+        for (UInt32 i = 0; i < count; ++i)
+        {
+            running += bins[i];
+            if (running >= target && running > 0)
+                return i;
+        }
+        return count - 1;
+    }
+
+    bool ParseRange(const char* text, Range& out)
+    {
+        char* end = nullptr;
+        out.from = std::strtof(text, &end);
+        if (end == text)
+            return false;
+
+        if (*end == '\0')
+        {
+            out.to = out.from;
+            out.steps = 1;
+            return true;
+        }
+
+        const char* p = end + 1;
+        if (*end != ':')
+            return false;
+        out.to = std::strtof(p, &end);
+        if (end == p || *end != ':')
+            return false;
+
+        p = end + 1;
+        out.steps = static_cast<UInt32>(std::strtoul(p, &end, 10));
+        return end != p && *end == '\0' && out.steps > 0;
+    }
+
+    bool ParseOptions(int argc, char** argv, Options& opt)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value)
+                return false;
+            ++i;
+
+            bool ok = true;
+            if (!std::strcmp(arg, "--ar-mult"))          ok = ParseRange(value, opt.arMult);
+            else if (!std::strcmp(arg, "--ar-flat"))     ok = ParseRange(value, opt.arFlat);
+            else if (!std::strcmp(arg, "--xp-per-hit"))  ok = ParseRange(value, opt.xpPerHit);
+            else if (!std::strcmp(arg, "--xp-factor"))   ok = ParseRange(value, opt.xpFactor);
+            else if (!std::strcmp(arg, "--level-cost"))  opt.levelCost = value;
+            else if (!std::strcmp(arg, "--runs"))        opt.runs = static_cast<UInt32>(std::strtoul(value, nullptr, 10));
+            else if (!std::strcmp(arg, "--encounters"))  opt.encounters = static_cast<UInt32>(std::strtoul(value, nullptr, 10));
+            else if (!std::strcmp(arg, "--hits"))        opt.hits = static_cast<UInt32>(std::strtoul(value, nullptr, 10));
+            else if (!std::strcmp(arg, "--checkpoints")) opt.checkpoints = static_cast<UInt32>(std::strtoul(value, nullptr, 10));
+            else if (!std::strcmp(arg, "--threads"))     opt.threads = static_cast<UInt32>(std::strtoul(value, nullptr, 10));
+            else if (!std::strcmp(arg, "--seed"))        opt.seed = std::strtoull(value, nullptr, 10);
+            else ok = false;
+
+            if (!ok)
+                return false;
+        }
+
+        opt.checkpoints = std::clamp<UInt32>(opt.checkpoints, 1, kMaxCheckpoints);
+        opt.checkpoints = std::min(opt.checkpoints, opt.encounters);
+        return opt.runs > 0 && opt.encounters > 0 && opt.hits > 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    if (!ParseOptions(argc, argv, opt))
+    {
+        std::fprintf(stderr, "usage: see the header of tools/BalanceSim.cpp\n");
+        return 2;
+    }
+
+    SkillCurve::Table levelCost = SkillCurve::kDefaultLevelCost;
+    if (opt.levelCost)
+    {
+        SkillCurve::CurveDef def;
+        if (!SkillCurve::Parse(opt.levelCost, 0.01f, def) || !SkillCurve::Compile(def, levelCost))
+        {
+            std::fprintf(stderr, "balancesim: bad --level-cost curve\n");
+            return 2;
+        }
+    }
+
+    // The default XP curve is kXPPerHit * max(1 - kXPSkillFactor * s/100, 0.05);
+    // express it as a SkillCurve definition so each grid point compiles its own.
+    std::vector<GridPoint> grid;
+    for (UInt32 a = 0; a < opt.arMult.steps; ++a)
+        for (UInt32 b = 0; b < opt.arFlat.steps; ++b)
+            for (UInt32 c = 0; c < opt.xpPerHit.steps; ++c)
+                for (UInt32 d = 0; d < opt.xpFactor.steps; ++d)
+                {
+                    GridPoint point = { opt.arMult.At(a), opt.arFlat.At(b), opt.xpPerHit.At(c), opt.xpFactor.At(d), {} };
+
+                    SkillCurve::CurveDef def = {};
+                    def.segments[0] = { 0.0f, SkillCurve::Shape::Linear, point.xpPerHit, -point.xpPerHit * point.xpFactor / 100.0f };
+                    def.count = 1;
+                    def.floor = point.xpPerHit * 0.05f;
+                    SkillCurve::Compile(def, point.xpGain);
+
+                    grid.push_back(point);
+                }
+
+    UInt32 checkpointAt[kMaxCheckpoints];
+    for (UInt32 i = 0; i < opt.checkpoints; ++i)
+        checkpointAt[i] = std::max<UInt32>(1, opt.encounters * (i + 1) / opt.checkpoints);
+
+    const UInt32 tasksPerPoint = (opt.runs + kRunsPerTask - 1) / kRunsPerTask;
+    const UInt32 taskCount = static_cast<UInt32>(grid.size()) * tasksPerPoint;
+    std::vector<Histograms> results(taskCount);
+
+    const UInt32 threads = opt.threads ? opt.threads : std::max(1u, std::thread::hardware_concurrency());
+    WorkStealingPool pool(threads);
+
+    const auto start = std::chrono::steady_clock::now();
+    pool.Run(taskCount, [&](UInt32 task)
+        {
+            const UInt32 pointIndex = task / tasksPerPoint;
+            const UInt32 chunk = task % tasksPerPoint;
+            const UInt32 runs = std::min(kRunsPerTask, opt.runs - chunk * kRunsPerTask);
+
+            // Seeded by task, not by worker, so output is thread-count independent.
+            Rng rng(opt.seed ^ SplitMix((static_cast<UInt64>(pointIndex) << 32) | chunk));
+            SimulateRuns(opt, grid[pointIndex], levelCost, checkpointAt, rng, runs, results[task]);
+        });
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("ar_mult,ar_flat,xp_per_hit,xp_factor");
+    for (UInt32 i = 0; i < opt.checkpoints; ++i)
+        std::printf(",skill_e%u_p10,skill_e%u_p50,skill_e%u_p90", checkpointAt[i], checkpointAt[i], checkpointAt[i]);
+    std::printf(",dmg_p10,dmg_p50,dmg_p90,dmg_mean\n");
+
+    UInt64 totalEncounters = 0;
+    for (UInt32 p = 0; p < grid.size(); ++p)
+    {
+        Histograms merged = {};
+        for (UInt32 t = 0; t < tasksPerPoint; ++t)
+        {
+            const Histograms& h = results[p * tasksPerPoint + t];
+            for (UInt32 c = 0; c < opt.checkpoints; ++c)
+                for (UInt32 s = 0; s < kSkillBins; ++s)
+                    merged.skill[c][s] += h.skill[c][s];
+            for (UInt32 d = 0; d < kDamageBins; ++d)
+                merged.damage[d] += h.damage[d];
+            merged.damageSum += h.damageSum;
+            merged.encounters += h.encounters;
+        }
+        totalEncounters += merged.encounters;
+
+        const GridPoint& point = grid[p];
+        std::printf("%g,%g,%g,%g", point.arMult, point.arFlat, point.xpPerHit, point.xpFactor);
+        for (UInt32 c = 0; c < opt.checkpoints; ++c)
+        {
+            std::printf(",%u,%u,%u",
+                Percentile(merged.skill[c], kSkillBins, 0.10),
+                Percentile(merged.skill[c], kSkillBins, 0.50),
+                Percentile(merged.skill[c], kSkillBins, 0.90));
+        }
+        std::printf(",%g,%g,%g,%.2f\n",
+            Percentile(merged.damage, kDamageBins, 0.10) * kDamageBinWidth,
+            Percentile(merged.damage, kDamageBins, 0.50) * kDamageBinWidth,
+            Percentile(merged.damage, kDamageBins, 0.90) * kDamageBinWidth,
+            merged.damageSum / std::max<UInt64>(1, merged.encounters));
+    }
+
+    std::fprintf(stderr, "balancesim: %zu grid points, %llu encounters on %u threads in %.2f s (%.1f M/s, %llu steals)\n",
+        grid.size(), static_cast<unsigned long long>(totalEncounters), threads, seconds,
+        totalEncounters / seconds / 1e6, static_cast<unsigned long long>(pool.GetStealCount()));
+    return 0;
+}
@@ -0,0 +1,834 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - tools/BattleBench.cpp
+//
+//  Macro benchmark: a mock siege of N actors carrying items drawn from M
+//  armour forms, with H hits per simulated frame going through the plugin's
+//  non-asm logic.  Per hit:
+//
+//      - the engine totals the target's AR: Hook 2 (IsHeavyArmor) and
+//        Hook 1 classify every equipped piece, and medium pieces go through
+//        CalcMediumPieceAR,
+//      - a script polls CountEquippedMediumArmor for the target,
+//      - hits on the player award XP through the real SkillCurve tables and
+//        bump the skill version like SetMediumArmorSkill does.
+//
+//  Between frames some actors swap a piece (equip churn) and armour wears
+//  down.
+//
+//  ARCache.cpp and SkillCurve.cpp are linked as is; FrameClock is the
+//  simulated frame counter (the plugin's is a Win32 timer).  The
+//  classification rule (Classifier.h), the XP advance and effective skill
+//  (Progression.h) and the wear summaries (WearTable.h) are the plugin's
+//  own code.  Only the engine side is mocked: ExtraContainerChanges lists,
+//  ExtraDataList presence bits, Calc_ArmorRating, and the MediumArmor.cpp
+//  walks over them; keywords come from the editor ID alone.
+//
+//  Build (Linux):
+//      g++ -O2 -std=c++20 -include tools/ToolPrefix.h -I.
+//          tools/BattleBench.cpp ARCache.cpp SkillCurve.cpp
+//          -o battlebench
+//
+//  Usage:
+//      battlebench [--actors N] [--forms N] [--inventory N] [--hits N]
+//                  [--frames N] [--churn P] [--medium-share P]
+//                  [--dynamic-share P] [--skill S]
+//                  [--seed N] [--sweep actors|forms|hits:A:B] [--csv]
+//                  [--scans] [--display N]
+//
+//  --sweep doubles the named parameter from A up to B, one row per value.
+//  --scans also times CountEquippedMediumArmor per actor, the inventory
+//  walk the plugin runs on every call, and checks its count against the
+//  worn pieces the mock world placed.
+//  --display runs an N-item merchant list through the Hook 3/Hook 4
+//  display path for 200 redraws, one per frame, with a skill change half
+//  way: per item, classification then the display AR cache by (form,
+//  condition), against classification, skill and Calc_ArmorRating on
+//  every redraw.  Checks both give the same AR.  The mock Calc_ArmorRating
+//  is a few multiplies, far cheaper than the engine's, so the saving shown
+//  is a lower bound.
+//  --csv prints machine-readable rows.  Frame times are wall clock of the
+//  hit loop plus churn; allocations count global operator new calls.
+// ============================================================================
+
+#include "ARCache.h"
+#include "Classifier.h"
+#include "Config.h"
+#include "FrameClock.h"
+#include "Progression.h"
+#include "SkillCurve.h"
+#include "SkillSync.h"
+#include "Timing.h"
+#include "WearTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace MediumArmor;
+
+// ── Allocation counter ──────────────────────────────────────────────────────
+static bool   g_countAllocs = false;
+static UInt64 g_allocs = 0;
+static UInt64 g_allocBytes = 0;
+
+void* operator new(std::size_t size)
+{
+    if (g_countAllocs)
+    {
+        ++g_allocs;
+        g_allocBytes += size;
+    }
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    if (g_countAllocs)
+    {
+        ++g_allocs;
+        g_allocBytes += size;
+    }
+    return std::malloc(size ? size : 1);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// ── Plugin stand-ins ARCache.cpp links against ──────────────────────────────
+namespace MediumArmor::FrameClock
+{
+    static uint32_t s_frame = 0;
+
+    uint32_t Current()
+    {
+        return s_frame;
+    }
+}
+
+namespace MediumArmor::SkillSync
+{
+    static Syncer s_syncer;
+
+    const Syncer& Get()
+    {
+        return s_syncer;
+    }
+}
+
+namespace
+{
+    // ── Engine model ───────────────────────────────────────────────────────
+    constexpr UInt8  kFormType_Armor = 0x14;
+    constexpr UInt8  kFormType_Misc = 0x1F;
+    constexpr UInt32 kExtraData_Worn = 0x16;
+    constexpr UInt32 kExtraData_WornLeft = 0x17;
+
+    // Calc_ArmorRating approximation; same as tools/BalanceSim.
+    constexpr float kLuckSkillMult = 0.4f;
+    constexpr float kSkillScaleMin = 0.5f;
+    constexpr float kSkillScaleMax = 1.5f;
+    constexpr float kConditionMin = 0.5f;
+    constexpr float kVanillaSkill = 50.0f;     // light/heavy skill of every actor
+
+    double CalcArmorRating(UInt16 baseAR, float skill, float luck, float condition)
+    {
+        const float luckSkill = std::clamp(skill + (luck - 50.0f) * kLuckSkillMult, 0.0f, 100.0f);
+        const float skillScale = kSkillScaleMin + (kSkillScaleMax - kSkillScaleMin) * luckSkill / 100.0f;
+        const float conditionScale = kConditionMin + (1.0f - kConditionMin) * condition;
+        return baseAR * skillScale * conditionScale;
+    }
+
+    struct MockForm
+    {
+        UInt32      refID;
+        UInt8       typeID;
+        UInt16      rawAR;          // base AR * 100, as at armorForm + 0xE4
+        int         maxHealth;
+        std::string editorID;
+    };
+
+    // tList-style: first node inline, the rest chained.
+    template <typename T>
+    struct Node
+    {
+        T*       item;
+        Node<T>* next;
+    };
+
+    struct ExtraList
+    {
+        UInt8 presence[0x18];
+
+        bool HasType(UInt32 type) const { return presence[type >> 3] & (1 << (type & 7)); }
+        void SetType(UInt32 type, bool on)
+        {
+            if (on)
+                presence[type >> 3] |= 1 << (type & 7);
+            else
+                presence[type >> 3] &= ~(1 << (type & 7));
+        }
+    };
+
+    struct EntryData
+    {
+        Node<ExtraList>* extendData;   // null = no extra lists
+        SInt32           countDelta;
+        MockForm*        type;
+    };
+
+    // What sub_488CB0 receives: the armour form sits at +8.
+    struct Instance
+    {
+        UInt32    unk0;
+        UInt32    unk4;
+        MockForm* form;
+        float     health;
+    };
+
+    struct Equipped
+    {
+        EntryData* entry;
+        ExtraList* worn;
+        Instance*  instance;
+    };
+
+    struct MockActor
+    {
+        UInt32                refID;
+        float                 luck;
+        Node<EntryData>*      objList;
+        std::vector<Equipped> equipped;
+        std::vector<EntryData*> spareArmor;   // carried, not worn
+    };
+
+    // ── MediumArmor.cpp on the mock engine ─────────────────────────────────
+    struct Plugin
+    {
+        std::vector<UInt32>   classIDs;
+        MediumArmorClassTable classTable = {};
+        float                 skill = 5.0f;
+
+        void PublishClassTable()
+        {
+            std::sort(classIDs.begin(), classIDs.end());
+            classTable = { classIDs.data(), static_cast<UInt32>(classIDs.size()), classTable.generation + 1 };
+        }
+
+        // Keywords are only modelled by editor ID, KeywordAPI's fallback.
+        bool IsMediumArmor(const MockForm* form) const
+        {
+            if (!form || form->typeID != kFormType_Armor)
+                return false;
+            return Classifier::IsMedium(classTable, form->refID,
+                [form] { return Classifier::EditorIDHasKeyword(form->editorID.c_str(), kMediumArmorKeyword); });
+        }
+
+        float Effective() const { return Progression::EffectiveSkill(skill, kARMultiplier, kARFlat); }
+
+        void AwardXP(float xp, UInt32 frame)
+        {
+            skill = SkillCurve::Advance(skill, xp);
+            SkillSync::s_syncer.NotifyChanged(Effective(), frame);
+        }
+
+        // Wear summaries
+        static constexpr UInt32 kWearCapacity = 1024;
+
+        MediumArmorWearSummary wear[kWearCapacity] = {};
+        UInt32 hook2Medium = 0;
+
+        static bool IsEntryEquipped(const EntryData* entry)
+        {
+            for (const Node<ExtraList>* n = entry->extendData; n; n = n->next)
+            {
+                if (n->item && (n->item->HasType(kExtraData_Worn) || n->item->HasType(kExtraData_WornLeft)))
+                    return true;
+            }
+            return false;
+        }
+
+        // Armour entries only; the rest are skipped before their extra
+        // lists are touched.
+        int CountEquippedMediumArmor(const MockActor& actor)
+        {
+            int count = 0;
+            for (const Node<EntryData>* n = actor.objList; n; n = n->next)
+            {
+                const EntryData* entry = n->item;
+                if (!entry || !entry->type || entry->type->typeID != kFormType_Armor)
+                    continue;
+                if (IsEntryEquipped(entry) && IsMediumArmor(entry->type))
+                    ++count;
+            }
+
+            WearTable::Record(wear, kWearCapacity, actor.refID, count);
+            return count;
+        }
+
+        // CalcMediumPieceAR
+        float PieceAR(const Instance& instance, const MockActor& actor)
+        {
+            const MockForm* form = instance.form;
+            const float condition = form->maxHealth ? instance.health / form->maxHealth : 0.0f;
+
+            const UInt16 baseAR = static_cast<UInt16>(form->rawAR / 100.0);
+            const float result = static_cast<float>(CalcArmorRating(baseAR, Effective(), actor.luck, condition));
+            return std::ceil(result);
+        }
+
+        // sub_488CB0 over the equipped set, with Hook 2 asking first.
+        float TotalAR(const MockActor& actor)
+        {
+            float total = 0.0f;
+            for (const Equipped& e : actor.equipped)
+            {
+                const MockForm* form = e.instance->form;
+
+                // Hook 2: skill selection asks IsHeavyArmor first; Hook 1's
+                // per-piece wrapper classifies again.
+                hook2Medium += IsMediumArmor(form) ? 1 : 0;
+                if (IsMediumArmor(form))
+                    total += PieceAR(*e.instance, actor);
+                else
+                {
+                    const float condition = e.instance->health / form->maxHealth;
+                    total += std::ceil(static_cast<float>(
+                        CalcArmorRating(static_cast<UInt16>(form->rawAR / 100), kVanillaSkill, actor.luck, condition)));
+                }
+            }
+            return total;
+        }
+    };
+
+    // ── World ──────────────────────────────────────────────────────────────
+    UInt64 SplitMix(UInt64 x)
+    {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    class Rng
+    {
+    public:
+        explicit Rng(UInt64 seed) : m_state(SplitMix(seed) | 1) {}
+
+        UInt64 Next()
+        {
+            m_state ^= m_state >> 12;
+            m_state ^= m_state << 25;
+            m_state ^= m_state >> 27;
+            return m_state * 0x2545F4914F6CDD1Dull;
+        }
+
+        UInt32 Below(UInt32 n) { return static_cast<UInt32>((Next() >> 32) * n >> 32); }
+        float  Unit() { return (Next() >> 40) / 16777216.0f; }
+
+    private:
+        UInt64 m_state;
+    };
+
+    struct Options
+    {
+        UInt32 actors = 200;
+        UInt32 forms = 2000;
+        UInt32 inventory = 40;      // entries per actor
+        UInt32 hits = 50;           // per frame
+        UInt32 frames = 2000;
+        float  churn = 0.02f;       // actors swapping a piece per frame
+        float  mediumShare = 0.35f;
+        float  dynamicShare = 0.05f;
+        float  skill = 5.0f;        // player's starting medium skill
+        UInt64 seed = 1;
+        bool   csv = false;
+        bool   scans = false;
+        UInt32 display = 0;         // merchant list items, 0 = off
+    };
+
+    // Owns every mock allocation; nodes are handed out in shuffled order so
+    // list walks jump around memory like the engine's heap.
+    struct World
+    {
+        std::vector<std::unique_ptr<MockForm>> forms;
+        std::vector<MockForm*> armor;
+        std::vector<MockForm*> misc;
+        std::vector<MockActor> actors;
+        std::vector<std::unique_ptr<UInt8[]>> arenas;
+
+        template <typename T>
+        std::vector<T*> Scatter(size_t count, Rng& rng)
+        {
+            arenas.emplace_back(new UInt8[count * sizeof(T)]());
+            T* base = reinterpret_cast<T*>(arenas.back().get());
+            std::vector<T*> out(count);
+            for (size_t i = 0; i < count; ++i)
+                out[i] = new (base + i) T();
+            for (size_t i = count; i > 1; --i)
+                std::swap(out[i - 1], out[rng.Below(static_cast<UInt32>(i))]);
+            return out;
+        }
+    };
+
+    void BuildWorld(const Options& opt, Rng& rng, World& world, Plugin& plugin)
+    {
+        for (UInt32 i = 0; i < opt.forms; ++i)
+        {
+            auto form = std::make_unique<MockForm>();
+            const bool dynamic = rng.Unit() < opt.dynamicShare;
+            const bool medium = rng.Unit() < opt.mediumShare;
+            form->refID = (dynamic ? 0xFF000000u : (rng.Below(40) << 24)) | (i + 1);
+            form->typeID = kFormType_Armor;
+            form->rawAR = static_cast<UInt16>((2 + rng.Below(20)) * 100);
+            form->maxHealth = 200 + static_cast<int>(rng.Below(800));
+            form->editorID = medium ? "ArmorMediumArmorPiece" : "ArmorPiece";
+            if (medium && !dynamic)
+                plugin.classIDs.push_back(form->refID);
+            world.armor.push_back(form.get());
+            world.forms.push_back(std::move(form));
+        }
+        for (UInt32 i = 0; i < 64; ++i)
+        {
+            auto form = std::make_unique<MockForm>();
+            form->refID = 0x00100000u | i;
+            form->typeID = kFormType_Misc;
+            world.misc.push_back(form.get());
+            world.forms.push_back(std::move(form));
+        }
+        plugin.PublishClassTable();
+
+        const size_t entryCount = static_cast<size_t>(opt.actors) * opt.inventory;
+        std::vector<EntryData*> entries = world.Scatter<EntryData>(entryCount, rng);
+        std::vector<Node<EntryData>*> entryNodes = world.Scatter<Node<EntryData>>(entryCount, rng);
+        std::vector<ExtraList*> extras = world.Scatter<ExtraList>(entryCount, rng);
+        std::vector<Node<ExtraList>*> extraNodes = world.Scatter<Node<ExtraList>>(entryCount, rng);
+        std::vector<Instance*> instances = world.Scatter<Instance>(entryCount, rng);
+
+        size_t next = 0;
+        world.actors.resize(opt.actors);
+        for (UInt32 a = 0; a < opt.actors; ++a)
+        {
+            MockActor& actor = world.actors[a];
+            actor.refID = 0x00010000u + a;      // actor 0 is the player
+            actor.luck = 30.0f + rng.Below(50);
+
+            Node<EntryData>* prev = nullptr;
+            for (UInt32 k = 0; k < opt.inventory; ++k, ++next)
+            {
+                const bool isArmor = k < 10 || rng.Below(3) == 0;
+                EntryData* entry = entries[next];
+                entry->countDelta = 1;
+                entry->type = isArmor ? world.armor[rng.Below(static_cast<UInt32>(world.armor.size()))]
+                                      : world.misc[rng.Below(static_cast<UInt32>(world.misc.size()))];
+
+                // Half the entries carry an extra list (the engine has one per
+                // instance with non-default state).
+                if (isArmor || rng.Below(2))
+                {
+                    extraNodes[next]->item = extras[next];
+                    entry->extendData = extraNodes[next];
+                }
+
+                Node<EntryData>* node = entryNodes[next];
+                node->item = entry;
+                if (prev)
+                    prev->next = node;
+                else
+                    actor.objList = node;
+                prev = node;
+
+                if (!isArmor)
+                    continue;
+
+                // The first five armour entries are worn.
+                if (actor.equipped.size() < 5 && k < 10)
+                {
+                    extras[next]->SetType(kExtraData_Worn, true);
+                    Instance* instance = instances[next];
+                    instance->form = entry->type;
+                    instance->health = static_cast<float>(entry->type->maxHealth) * (0.5f + 0.5f * rng.Unit());
+                    actor.equipped.push_back({ entry, extras[next], instance });
+                }
+                else
+                {
+                    actor.spareArmor.push_back(entry);
+                }
+            }
+        }
+    }
+
+    // Swaps one worn piece for a carried one: the worn flags move.
+    void SwapPiece(MockActor& actor, Rng& rng, std::vector<Instance*>& pool)
+    {
+        if (actor.equipped.empty() || actor.spareArmor.empty())
+            return;
+
+        Equipped& slot = actor.equipped[rng.Below(static_cast<UInt32>(actor.equipped.size()))];
+        const UInt32 spareIndex = rng.Below(static_cast<UInt32>(actor.spareArmor.size()));
+        EntryData* incoming = actor.spareArmor[spareIndex];
+        if (!incoming->extendData)
+            return;
+
+        slot.worn->SetType(kExtraData_Worn, false);
+        actor.spareArmor[spareIndex] = slot.entry;
+
+        ExtraList* worn = incoming->extendData->item;
+        worn->SetType(kExtraData_Worn, true);
+
+        Instance* instance = pool.back();
+        pool.pop_back();
+        pool.insert(pool.begin(), slot.instance);
+        instance->form = incoming->type;
+        instance->health = static_cast<float>(incoming->type->maxHealth);
+        slot = { incoming, worn, instance };
+    }
+
+    struct Result
+    {
+        Options opt;
+        double  p50Us;
+        double  p99Us;
+        double  maxUs;
+        double  meanUs;
+        double  nsPerHit;
+        double  allocsPerFrame;
+        double  bytesPerFrame;
+        float   finalSkill;
+    };
+
+    Result Run(const Options& opt)
+    {
+        Rng rng(opt.seed);
+        World world;
+        Plugin plugin;
+        plugin.skill = opt.skill;
+        BuildWorld(opt, rng, world, plugin);
+
+        SkillSync::s_syncer = SkillSync::Syncer();
+
+        // Spare instances for swapped-in pieces.
+        std::vector<Instance*> instancePool = world.Scatter<Instance>(256, rng);
+
+        const UInt32 warmup = std::min<UInt32>(opt.frames / 10, 200);
+        std::vector<double> frameUs;
+        frameUs.reserve(opt.frames);
+
+        UInt64 allocs = 0, allocBytes = 0;
+        UInt64 hitsTimed = 0;
+        UInt64 nsTimed = 0;
+        volatile float sink = 0.0f;
+
+        for (UInt32 frame = 0; frame < opt.frames + warmup; ++frame)
+        {
+            const bool timed = frame >= warmup;
+            FrameClock::s_frame = frame;
+
+            // Pick the frame's hits before the clock starts.
+            UInt32 targets[4096];
+            const UInt32 hits = std::min<UInt32>(opt.hits, 4096);
+            for (UInt32 h = 0; h < hits; ++h)
+                targets[h] = rng.Below(opt.actors);
+
+            g_allocs = 0;
+            g_allocBytes = 0;
+            g_countAllocs = timed;
+            const UInt64 t0 = Timing::NowNs();
+
+            for (UInt32 h = 0; h < hits; ++h)
+            {
+                MockActor& target = world.actors[targets[h]];
+                sink = sink + plugin.TotalAR(target);
+                sink = sink + static_cast<float>(plugin.CountEquippedMediumArmor(target));
+
+                if (targets[h] == 0)
+                    plugin.AwardXP(SkillCurve::XPGain(plugin.skill), frame);
+
+                // Wear on the piece that took the hit.
+                if (!target.equipped.empty())
+                {
+                    Instance* piece = target.equipped[h % target.equipped.size()].instance;
+                    piece->health = std::max(1.0f, piece->health - 1.0f);
+                }
+            }
+
+            const UInt32 swaps = static_cast<UInt32>(opt.churn * opt.actors + rng.Unit());
+            for (UInt32 s = 0; s < swaps; ++s)
+                SwapPiece(world.actors[rng.Below(opt.actors)], rng, instancePool);
+
+            const UInt64 elapsed = Timing::NowNs() - t0;
+            g_countAllocs = false;
+
+            if (timed)
+            {
+                frameUs.push_back(elapsed / 1e3);
+                allocs += g_allocs;
+                allocBytes += g_allocBytes;
+                hitsTimed += hits;
+                nsTimed += elapsed;
+            }
+        }
+
+        std::vector<double> sorted = frameUs;
+        std::sort(sorted.begin(), sorted.end());
+        auto pct = [&](double p)
+            {
+                return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()))];
+            };
+
+
+        Result r = {};
+        r.opt = opt;
+        r.p50Us = pct(0.50);
+        r.p99Us = pct(0.99);
+        r.maxUs = sorted.back();
+        r.meanUs = nsTimed / 1e3 / opt.frames;
+        r.nsPerHit = hitsTimed ? static_cast<double>(nsTimed) / hitsTimed : 0.0;
+        r.allocsPerFrame = static_cast<double>(allocs) / opt.frames;
+        r.bytesPerFrame = static_cast<double>(allocBytes) / opt.frames;
+        r.finalSkill = plugin.skill;
+        return r;
+    }
+
+    // Per-actor cost of CountEquippedMediumArmor, which walks the inventory
+    // on every call.  False if a count disagrees with the pieces the world
+    // put on the actor.
+    bool TimeScans(const Options& opt)
+    {
+        Rng rng(opt.seed);
+        World world;
+        auto plugin = std::make_unique<Plugin>();
+        BuildWorld(opt, rng, world, *plugin);
+
+        constexpr UInt32 kPasses = 50;
+        UInt64 countNs = 0;
+        UInt32 mismatches = 0;
+        volatile UInt64 sink = 0;
+        std::vector<Instance*> instancePool = world.Scatter<Instance>(256, rng);
+
+        for (UInt32 pass = 0; pass < kPasses; ++pass)
+        {
+            const UInt64 t0 = Timing::NowNs();
+            for (const MockActor& actor : world.actors)
+                sink = sink + plugin->CountEquippedMediumArmor(actor);
+            countNs += Timing::NowNs() - t0;
+
+            for (const MockActor& actor : world.actors)
+            {
+                int expected = 0;
+                for (const Equipped& e : actor.equipped)
+                    expected += plugin->IsMediumArmor(e.instance->form) ? 1 : 0;
+                mismatches += plugin->CountEquippedMediumArmor(actor) != expected ? 1 : 0;
+            }
+
+            // Move some pieces so the next pass counts different sets.
+            for (UInt32 i = 0; i < opt.actors / 4; ++i)
+                SwapPiece(world.actors[rng.Below(opt.actors)], rng, instancePool);
+        }
+
+        const double perActor = static_cast<double>(kPasses) * world.actors.size();
+        std::printf("\nCountEquippedMediumArmor, per actor (%u entries, %u passes):\n", opt.inventory, kPasses);
+        std::printf("  inventory walk     %8.1f ns\n", countNs / perActor);
+        std::printf("%s  counts match the worn pieces (%u mismatches)\n", mismatches ? "FAIL" : "ok  ", mismatches);
+        return mismatches == 0;
+    }
+
+    // The inventory display path per listed item, as Hooks.cpp runs it.
+    // False if the cached path disagrees with a full recompute.
+    bool CompareDisplay(const Options& opt)
+    {
+        Rng rng(opt.seed);
+        World world;
+        auto plugin = std::make_unique<Plugin>();
+        BuildWorld(opt, rng, world, *plugin);
+
+        struct Item
+        {
+            const MockForm* form;
+            float           condition;
+        };
+        std::vector<Item> list(opt.display);
+        for (Item& item : list)
+            item = { world.armor[rng.Below(static_cast<UInt32>(world.armor.size()))], 0.25f + 0.75f * rng.Unit() };
+
+        constexpr UInt32 kRedraws = 200;
+        const float luck = 50.0f;
+        UInt64 classifyNs = 0, fullNs = 0, cachedNs = 0;
+        UInt32 mismatches = 0;
+        volatile double sink = 0.0;
+        std::vector<double> full(list.size());
+        const ARCache::Stats before = ARCache::GetDisplayStats();
+
+        for (UInt32 redraw = 0; redraw < kRedraws; ++redraw)
+        {
+            FrameClock::s_frame += 1;
+            if (redraw == kRedraws / 2)
+                plugin->AwardXP(5.0f, FrameClock::s_frame);
+
+            // Hook 3's classification, which both paths pay.
+            UInt64 t0 = Timing::NowNs();
+            for (const Item& item : list)
+                sink = sink + (plugin->IsMediumArmor(item.form) ? 1.0 : 0.0);
+            classifyNs += Timing::NowNs() - t0;
+
+            // Before: Hook 3 classifies and reads the skill, Hook 4 swaps it
+            // in and runs Calc_ArmorRating, every redraw.
+            t0 = Timing::NowNs();
+            for (size_t i = 0; i < list.size(); ++i)
+            {
+                const MockForm* form = list[i].form;
+                const UInt16 baseAR = static_cast<UInt16>(form->rawAR / 100.0);
+                const float skill = plugin->IsMediumArmor(form) ? plugin->Effective() : kVanillaSkill;
+                full[i] = CalcArmorRating(baseAR, skill, luck, list[i].condition);
+                sink = sink + full[i];
+            }
+            fullNs += Timing::NowNs() - t0;
+
+            // Now: Hook 3 classifies and remembers the form; Hook 4 reads
+            // the skill and runs Calc_ArmorRating only on a miss.
+            t0 = Timing::NowNs();
+            for (size_t i = 0; i < list.size(); ++i)
+            {
+                const MockForm* form = list[i].form;
+                const UInt16 baseAR = static_cast<UInt16>(form->rawAR / 100.0);
+                double value = 0.0;
+                if (!plugin->IsMediumArmor(form))
+                    value = CalcArmorRating(baseAR, kVanillaSkill, luck, list[i].condition);
+                else if (!ARCache::LookupDisplay(form, baseAR, luck, list[i].condition, value))
+                {
+                    value = CalcArmorRating(baseAR, plugin->Effective(), luck, list[i].condition);
+                    ARCache::StoreDisplay(form, baseAR, luck, list[i].condition, value);
+                }
+                sink = sink + value;
+                mismatches += value != full[i] ? 1 : 0;
+            }
+            cachedNs += Timing::NowNs() - t0;
+        }
+
+        const ARCache::Stats& after = ARCache::GetDisplayStats();
+        const UInt32 hits = after.hits - before.hits;
+        const UInt32 misses = after.misses - before.misses;
+        const double perItem = static_cast<double>(kRedraws) * list.size();
+        std::printf("\ninventory display AR, per listed item (%u items, %u redraws, skill change at %u):\n",
+            opt.display, kRedraws, kRedraws / 2);
+        std::printf("  classification     %8.1f ns  (in both below)\n", classifyNs / perItem);
+        std::printf("  recompute          %8.1f ns\n", fullNs / perItem);
+        std::printf("  display cache      %8.1f ns  (%u hits, %u misses, %u clears)\n",
+            cachedNs / perItem, hits, misses, after.clears - before.clears);
+        std::printf("%s  cached display AR matches the recompute (%u mismatches)\n", mismatches ? "FAIL" : "ok  ", mismatches);
+        return mismatches == 0;
+    }
+
+    void PrintHeader(bool csv)
+    {
+        if (csv)
+            std::printf("actors,forms,inventory,hits,frames,p50_us,p99_us,max_us,mean_us,ns_per_hit,"
+                "allocs_per_frame,bytes_per_frame,final_skill\n");
+        else
+            std::printf("%7s %6s %5s %5s | %9s %9s %9s %9s | %8s | %7s %9s | %5s\n",
+                "actors", "forms", "inv", "hits", "p50 us", "p99 us", "max us", "mean us",
+                "ns/hit", "allocs", "bytes", "skill");
+    }
+
+    void PrintRow(const Result& r, bool csv)
+    {
+        const Options& o = r.opt;
+        if (csv)
+            std::printf("%u,%u,%u,%u,%u,%.2f,%.2f,%.2f,%.2f,%.1f,%.2f,%.1f,%.2f\n",
+                o.actors, o.forms, o.inventory, o.hits, o.frames, r.p50Us, r.p99Us, r.maxUs, r.meanUs,
+                r.nsPerHit, r.allocsPerFrame, r.bytesPerFrame, r.finalSkill);
+        else
+            std::printf("%7u %6u %5u %5u | %9.2f %9.2f %9.2f %9.2f | %8.1f | %7.2f %9.1f | %5.1f\n",
+                o.actors, o.forms, o.inventory, o.hits, r.p50Us, r.p99Us, r.maxUs, r.meanUs,
+                r.nsPerHit, r.allocsPerFrame, r.bytesPerFrame, r.finalSkill);
+    }
+
+    bool ParseOptions(int argc, char** argv, Options& opt, const char*& sweep, UInt32& from, UInt32& to)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* arg = argv[i];
+            if (!std::strcmp(arg, "--csv"))
+            {
+                opt.csv = true;
+                continue;
+            }
+            if (!std::strcmp(arg, "--scans"))
+            {
+                opt.scans = true;
+                continue;
+            }
+            if (i + 1 == argc)
+                return false;
+
+            const char* value = argv[++i];
+            if (!std::strcmp(arg, "--display"))             opt.display = std::strtoul(value, nullptr, 10);
+            else if (!std::strcmp(arg, "--actors"))         opt.actors = std::strtoul(value, nullptr, 10);
+            else if (!std::strcmp(arg, "--forms"))          opt.forms = std::strtoul(value, nullptr, 10);
+            else if (!std::strcmp(arg, "--inventory"))      opt.inventory = std::strtoul(value, nullptr, 10);
+            else if (!std::strcmp(arg, "--hits"))           opt.hits = std::strtoul(value, nullptr, 10);
+            else if (!std::strcmp(arg, "--frames"))         opt.frames = std::strtoul(value, nullptr, 10);
+            else if (!std::strcmp(arg, "--churn"))          opt.churn = std::strtof(value, nullptr);
+            else if (!std::strcmp(arg, "--medium-share"))   opt.mediumShare = std::strtof(value, nullptr);
+            else if (!std::strcmp(arg, "--dynamic-share"))  opt.dynamicShare = std::strtof(value, nullptr);
+            else if (!std::strcmp(arg, "--skill"))          opt.skill = std::strtof(value, nullptr);
+            else if (!std::strcmp(arg, "--seed"))           opt.seed = std::strtoull(value, nullptr, 10);
+            else if (!std::strcmp(arg, "--sweep"))
+            {
+                static char name[16];
+                unsigned a = 0, b = 0;
+                if (std::sscanf(value, "%15[a-z]:%u:%u", name, &a, &b) != 3 || !a || b < a)
+                    return false;
+                if (std::strcmp(name, "actors") && std::strcmp(name, "forms") && std::strcmp(name, "hits"))
+                    return false;
+                sweep = name;
+                from = a;
+                to = b;
+            }
+            else
+                return false;
+        }
+
+        return opt.actors && opt.forms && opt.inventory >= 10 && opt.frames;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    const char* sweep = nullptr;
+    UInt32 from = 0, to = 0;
+    if (!ParseOptions(argc, argv, opt, sweep, from, to))
+    {
+        std::fprintf(stderr, "usage: see the header of tools/BattleBench.cpp (--inventory must be at least 10)\n");
+        return 2;
+    }
+
+    PrintHeader(opt.csv);
+
+    if (!sweep)
+    {
+        PrintRow(Run(opt), opt.csv);
+        bool ok = !opt.scans || TimeScans(opt);
+        ok &= !opt.display || CompareDisplay(opt);
+        return ok ? 0 : 1;
+    }
+
+    for (UInt64 v = from; v <= to; v *= 2)
+    {
+        Options point = opt;
+        UInt32& target = !std::strcmp(sweep, "actors") ? point.actors
+                       : !std::strcmp(sweep, "forms")  ? point.forms
+                                                       : point.hits;
+        target = static_cast<UInt32>(v);
+        PrintRow(Run(point), opt.csv);
+        std::fflush(stdout);
+    }
+    return 0;
+}
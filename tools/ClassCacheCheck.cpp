@@ -0,0 +1,181 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - tools/ClassCacheCheck.cpp
+//
+//  Checks the platform-neutral half of ClassificationCache: an image
+//  written by Serialize() validates and reads back the same form IDs, also
+//  after a trip through a file; a flipped byte anywhere, a short or long
+//  file, unsorted IDs and a different fingerprint are all rejected; and
+//  the fingerprint seed changes with the classifier version.
+//
+//  Build (Linux):
+//      g++ -O2 -std=c++20 -include tools/ToolPrefix.h -I.
+//          tools/ClassCacheCheck.cpp ClassificationCache.cpp -o classcachecheck
+//
+//  Exit code is non-zero if any check fails.
+// ============================================================================
+
+#include "ClassificationCache.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+namespace
+{
+    namespace Cache = MediumArmor::ClassificationCache;
+
+    int s_failed = 0;
+
+    void Check(bool ok, const char* what)
+    {
+        std::printf("%s  %s\n", ok ? "ok  " : "FAIL", what);
+        if (!ok)
+            ++s_failed;
+    }
+
+    const uint32_t kFormIDs[] = { 0x0000A1F3, 0x0001C2B0, 0x00022D10, 0x01000ED4, 0x0200101F };
+    const uint32_t kCount = sizeof(kFormIDs) / sizeof(kFormIDs[0]);
+
+    uint64_t Fingerprint()
+    {
+        return Cache::HashString("MediumArmor", Cache::FingerprintSeed());
+    }
+
+    bool ReadsBack(const std::vector<uint8_t>& image, uint64_t fingerprint)
+    {
+        const uint32_t* formIDs = nullptr;
+        uint32_t count = 0;
+        if (!Cache::Validate(image.data(), image.size(), fingerprint, &formIDs, &count))
+            return false;
+        return count == kCount && std::memcmp(formIDs, kFormIDs, sizeof(kFormIDs)) == 0;
+    }
+
+    bool Rejected(const std::vector<uint8_t>& image, uint64_t fingerprint)
+    {
+        return !Cache::Validate(image.data(), image.size(), fingerprint, nullptr, nullptr);
+    }
+
+    void CheckRoundTrip()
+    {
+        const uint64_t fingerprint = Fingerprint();
+        const std::vector<uint8_t> image = Cache::Serialize(fingerprint, kFormIDs, kCount);
+        Check(image.size() == sizeof(Cache::Header) + sizeof(kFormIDs), "image is header + IDs");
+        Check(ReadsBack(image, fingerprint), "serialized image validates and reads back");
+
+        const std::vector<uint8_t> empty = Cache::Serialize(fingerprint, nullptr, 0);
+        uint32_t count = 1;
+        Check(Cache::Validate(empty.data(), empty.size(), fingerprint, nullptr, &count) && count == 0,
+            "an empty table round-trips");
+
+        // Through a file, the way Write() and Map() use it.
+        char path[] = "/tmp/classcachecheck.XXXXXX";
+        const int fd = mkstemp(path);
+        std::FILE* f = fd >= 0 ? fdopen(fd, "w+b") : nullptr;
+        std::vector<uint8_t> loaded(image.size() + 16);
+        size_t read = 0;
+        if (f)
+        {
+            std::fwrite(image.data(), 1, image.size(), f);
+            std::rewind(f);
+            read = std::fread(loaded.data(), 1, loaded.size(), f);
+            std::fclose(f);
+            std::remove(path);
+        }
+        loaded.resize(read);
+        Check(f && ReadsBack(loaded, fingerprint), "an image read back from a file validates");
+    }
+
+    void CheckCorrupt()
+    {
+        const uint64_t fingerprint = Fingerprint();
+        const std::vector<uint8_t> image = Cache::Serialize(fingerprint, kFormIDs, kCount);
+
+        // Every single-bit flip, header or body, must be caught: magic,
+        // version, fingerprint and count by comparison, IDs by ordering or
+        // checksum, the checksum by itself.
+        uint32_t accepted = 0;
+        for (size_t byte = 0; byte < image.size(); ++byte)
+        {
+            for (int bit = 0; bit < 8; ++bit)
+            {
+                std::vector<uint8_t> bad = image;
+                bad[byte] ^= static_cast<uint8_t>(1u << bit);
+                accepted += Rejected(bad, fingerprint) ? 0 : 1;
+            }
+        }
+        Check(accepted == 0, "every single-bit flip is rejected");
+
+        std::vector<uint8_t> version = image;
+        const uint32_t next = Cache::kFormatVersion + 1;
+        std::memcpy(version.data() + offsetof(Cache::Header, version), &next, sizeof(next));
+        Check(Rejected(version, fingerprint), "a newer format version is rejected");
+
+        // Swapped IDs with a checksum recomputed to match: only the order
+        // check can catch it.
+        uint32_t swapped[kCount];
+        std::memcpy(swapped, kFormIDs, sizeof(swapped));
+        std::swap(swapped[1], swapped[2]);
+        Check(Rejected(Cache::Serialize(fingerprint, swapped, kCount), fingerprint), "unsorted IDs are rejected");
+
+        uint32_t duplicate[kCount];
+        std::memcpy(duplicate, kFormIDs, sizeof(duplicate));
+        duplicate[3] = duplicate[2];
+        Check(Rejected(Cache::Serialize(fingerprint, duplicate, kCount), fingerprint), "duplicate IDs are rejected");
+
+        Check(!Cache::Validate(nullptr, 0, fingerprint, nullptr, nullptr), "no image is rejected");
+    }
+
+    void CheckTruncated()
+    {
+        const uint64_t fingerprint = Fingerprint();
+        const std::vector<uint8_t> image = Cache::Serialize(fingerprint, kFormIDs, kCount);
+
+        uint32_t accepted = 0;
+        for (size_t size = 0; size < image.size(); ++size)
+            accepted += Cache::Validate(image.data(), size, fingerprint, nullptr, nullptr) ? 1 : 0;
+        Check(accepted == 0, "every truncation is rejected");
+
+        std::vector<uint8_t> longer = image;
+        longer.push_back(0);
+        Check(Rejected(longer, fingerprint), "trailing bytes are rejected");
+
+        // A whole ID short, with the count rewritten to match: the checksum
+        // still covers the dropped ID.
+        std::vector<uint8_t> shorter(image.begin(), image.end() - sizeof(uint32_t));
+        const uint32_t count = kCount - 1;
+        std::memcpy(shorter.data() + offsetof(Cache::Header, count), &count, sizeof(count));
+        Check(Rejected(shorter, fingerprint), "a dropped ID with a matching count is rejected");
+    }
+
+    void CheckStaleFingerprint()
+    {
+        const uint64_t fingerprint = Fingerprint();
+        const std::vector<uint8_t> image = Cache::Serialize(fingerprint, kFormIDs, kCount);
+
+        Check(Rejected(image, fingerprint + 1), "a different fingerprint is rejected");
+        Check(Rejected(image, Cache::HashString("MediumArmour", Cache::FingerprintSeed())),
+            "a different keyword is a different fingerprint");
+
+        const uint64_t older = Cache::HashString("MediumArmor", Cache::FingerprintSeed(Cache::kClassifierVersion - 1));
+        Check(older != fingerprint, "the classifier version changes the fingerprint");
+        Check(Rejected(Cache::Serialize(older, kFormIDs, kCount), fingerprint),
+            "a cache from an older classifier is rejected");
+        Check(Cache::FingerprintSeed() == Cache::FingerprintSeed(Cache::kClassifierVersion),
+            "the seed is stable for one version");
+
+        Check(Cache::HashString("ab", Cache::HashString("c")) != Cache::HashString("a", Cache::HashString("bc")),
+            "string boundaries are part of the hash");
+    }
+}
+
+int main()
+{
+    CheckRoundTrip();
+    CheckCorrupt();
+    CheckTruncated();
+    CheckStaleFingerprint();
+
+    std::printf("\n%d failed\n", s_failed);
+    return s_failed ? 1 : 0;
+}
@@ -0,0 +1,210 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - tools/EpochCheck.cpp
+//
+//  Checks ChangeEpochs::Tracker: epochs only go up and every change gets
+//  its own, unchanged values keep theirs, the 33rd watched actor replaces
+//  the one asked about longest ago, counts taken elsewhere only land on
+//  watched actors, the per-frame refresh reads a bounded slice in turn and
+//  drops gone actors, epochs from a later session count as "before
+//  anything", and clearing the watched set keeps the counter.
+//
+//  Build (Linux):
+//      g++ -O2 -std=c++20 -include tools/ToolPrefix.h -I.
+//          tools/EpochCheck.cpp -o epochcheck
+//
+//  Exit code is non-zero if any check fails.
+// ============================================================================
+
+#include "ChangeEpochs.h"
+
+#include <map>
+
+namespace
+{
+    using MediumArmor::ChangeEpochs::ActorChange;
+    using MediumArmor::ChangeEpochs::Tracker;
+    using MediumArmor::ChangeEpochs::kMaxWatched;
+
+    int s_failed = 0;
+
+    void Check(bool ok, const char* what)
+    {
+        std::printf("%s  %s\n", ok ? "ok  " : "FAIL", what);
+        if (!ok)
+            ++s_failed;
+    }
+
+    bool IsWatched(const Tracker& tracker, UInt32 refID)
+    {
+        ActorChange changes[kMaxWatched];
+        const UInt32 n = tracker.ActorsChangedSince(0, changes, kMaxWatched);
+        for (UInt32 i = 0; i < n; ++i)
+        {
+            if (changes[i].refID == refID)
+                return true;
+        }
+        return false;
+    }
+
+    void CheckOrdering()
+    {
+        Tracker tracker;
+        const UInt32 start = tracker.Current();
+        Check(start != 0 && !tracker.HasChangesSince(start), "a fresh tracker has nothing newer than its epoch");
+
+        tracker.NoteSkill(25.0f);
+        const UInt32 skill1 = tracker.SkillEpoch();
+        Check(skill1 > start && skill1 == tracker.Current(), "a skill change takes the next epoch");
+
+        tracker.NoteSkill(25.0f);
+        Check(tracker.SkillEpoch() == skill1 && tracker.Current() == skill1, "an unchanged skill keeps its epoch");
+
+        tracker.NoteActor(0x14, 2, 1);
+        const UInt32 player = tracker.Current();
+        Check(player > skill1, "watching an actor takes the next epoch");
+
+        tracker.NoteActor(0x14, 2, 2);
+        Check(tracker.Current() == player, "re-noting the same count hands out nothing");
+
+        tracker.NoteActor(0x14, 3, 3);
+        ActorChange changes[kMaxWatched];
+        UInt32 n = tracker.ActorsChangedSince(player, changes, kMaxWatched);
+        Check(n == 1 && changes[0].refID == 0x14 && changes[0].mediumCount == 3 && changes[0].epoch == tracker.Current(),
+            "a count change is reported after the epoch before it");
+
+        n = tracker.ActorsChangedSince(tracker.Current(), changes, kMaxWatched);
+        Check(n == 0 && !tracker.HasChangesSince(tracker.Current()), "nothing is reported after the latest epoch");
+        Check(tracker.HasChangesSince(player), "HasChangesSince sees actor changes");
+    }
+
+    void CheckObserve()
+    {
+        Tracker tracker;
+        tracker.NoteActor(0x14, 2, 1);
+        const UInt32 before = tracker.Current();
+
+        tracker.Observe(0x30, 5);
+        Check(!tracker.IsWatched(0x30) && tracker.Current() == before, "a count for an unwatched actor is ignored");
+
+        tracker.Observe(0x14, 2);
+        Check(tracker.Current() == before, "an unchanged observed count hands out nothing");
+
+        tracker.Observe(0x14, 0);
+        ActorChange changes[kMaxWatched];
+        const UInt32 n = tracker.ActorsChangedSince(before, changes, kMaxWatched);
+        Check(n == 1 && changes[0].refID == 0x14 && changes[0].mediumCount == 0, "a watched actor's observed change is reported");
+    }
+
+    void CheckRefresh()
+    {
+        Tracker tracker;
+        for (UInt32 i = 0; i < 10; ++i)
+            tracker.NoteActor(0x100 + i, 1, 1);
+
+        std::map<UInt32, int> reads;
+        auto countOf = [&reads](UInt32 refID, int& count)
+            {
+                ++reads[refID];
+                count = 1;
+                return true;
+            };
+
+        tracker.RefreshSome(4, countOf);
+        Check(reads.size() == 4, "a refresh reads at most the slice it is given");
+
+        tracker.RefreshSome(4, countOf);
+        tracker.RefreshSome(4, countOf);
+        bool all = reads.size() == 10;
+        for (const auto& r : reads)
+            all &= r.second == 1 || r.second == 2;
+        Check(all, "successive slices carry on round the watched set");
+
+        const UInt32 before = tracker.Current();
+        tracker.RefreshSome(kMaxWatched, [](UInt32 refID, int& count)
+            {
+                count = refID == 0x105 ? 3 : 1;
+                return refID != 0x107;
+            });
+        ActorChange changes[kMaxWatched];
+        const UInt32 n = tracker.ActorsChangedSince(before, changes, kMaxWatched);
+        Check(n == 1 && changes[0].refID == 0x105 && changes[0].mediumCount == 3, "refresh reports only counts that moved");
+        Check(!tracker.IsWatched(0x107) && tracker.WatchedCount() == 9, "a gone actor stops being watched");
+
+        tracker.UnwatchIf([](UInt32 refID) { return refID < 0x104; });
+        Check(tracker.WatchedCount() == 5 && !tracker.IsWatched(0x100) && tracker.IsWatched(0x104),
+            "UnwatchIf drops exactly the actors it is told to");
+
+        tracker.RefreshSome(4, [](UInt32, int&) { return false; });
+        tracker.RefreshSome(4, [](UInt32, int&) { return false; });
+        Check(tracker.WatchedCount() == 0, "a refresh over an emptying set stops cleanly");
+    }
+
+    void CheckReplacement()
+    {
+        Tracker tracker;
+        for (UInt32 i = 0; i < kMaxWatched; ++i)
+            tracker.NoteActor(0x100 + i, 1, 10 + i);
+        Check(tracker.WatchedCount() == kMaxWatched, "the first kMaxWatched actors are all watched");
+
+        // Ask about the first actor again: the second is now the oldest.
+        tracker.NoteActor(0x100, 1, 100);
+        tracker.NoteActor(0x200, 4, 101);
+        Check(tracker.WatchedCount() == kMaxWatched, "the watched set never grows past kMaxWatched");
+        Check(IsWatched(tracker, 0x200), "a new actor past the limit is watched");
+        Check(!IsWatched(tracker, 0x101), "it replaces the actor asked about longest ago");
+        Check(IsWatched(tracker, 0x100) && IsWatched(tracker, 0x102), "recently asked actors stay");
+
+        ActorChange changes[kMaxWatched];
+        const UInt32 n = tracker.ActorsChangedSince(tracker.Current() - 1, changes, kMaxWatched);
+        Check(n == 1 && changes[0].refID == 0x200 && changes[0].mediumCount == 4,
+            "the replacement starts with its own epoch and count");
+    }
+
+    void CheckFutureEpoch()
+    {
+        Tracker tracker;
+        tracker.NoteSkill(10.0f);
+        tracker.NoteActor(0x14, 1, 1);
+
+        // A script saved at epoch 500 in another session, loaded into this one.
+        const UInt32 future = tracker.Current() + 500;
+        Check(tracker.HasChangesSince(future), "an epoch newer than Current() counts as 0");
+
+        ActorChange changes[kMaxWatched];
+        Check(tracker.ActorsChangedSince(future, changes, kMaxWatched) == 1, "... so every watched actor is reported");
+
+        tracker.NoteActor(0x15, 2, 2);
+        Check(tracker.ActorsChangedSince(0, changes, 1) == 1, "the copy stops at maxOut");
+    }
+
+    void CheckClear()
+    {
+        Tracker tracker;
+        tracker.NoteActor(0x14, 2, 1);
+        tracker.NoteActor(0x15, 1, 1);
+        const UInt32 before = tracker.Current();
+
+        tracker.ClearWatched();
+        ActorChange changes[kMaxWatched];
+        Check(tracker.WatchedCount() == 0 && tracker.ActorsChangedSince(0, changes, kMaxWatched) == 0,
+            "clear forgets every watched actor");
+        Check(tracker.Current() == before && !tracker.HasChangesSince(before), "clear keeps the counter");
+
+        tracker.NoteActor(0x14, 2, 2);
+        Check(tracker.Current() > before && tracker.HasChangesSince(before),
+            "an actor watched again after clear is reported to old epochs");
+    }
+}
+
+int main()
+{
+    CheckOrdering();
+    CheckObserve();
+    CheckRefresh();
+    CheckReplacement();
+    CheckFutureEpoch();
+    CheckClear();
+
+    std::printf("\n%d failed\n", s_failed);
+    return s_failed ? 1 : 0;
+}
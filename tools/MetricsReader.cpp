@@ -0,0 +1,354 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - tools/MetricsReader.cpp
+//
+//  Reads the metrics page (MetricsPage.h) from POSIX shared memory, the
+//  stand-in for the plugin's Local\MediumArmorMetrics mapping, and prints
+//  counters and per-second rates.  Also:
+//
+//      --demo-writer   publishes synthetic counters at ~60 Hz, so the reader
+//                      (or an overlay) can be tried without the game,
+//      --check         runs a writer thread against reader threads, each on
+//                      its own mapping of one segment, and verifies that no
+//                      torn payload is ever accepted.
+//
+//  Build (Linux):
+//      g++ -O2 -std=c++20 -pthread -include tools/ToolPrefix.h -I.
+//          tools/MetricsReader.cpp -o metricsreader
+//
+//  Usage:
+//      metricsreader [--name /shm-name] [--interval ms] [--once]
+//      metricsreader --demo-writer [--name /shm-name] [--seconds N]
+//      metricsreader --check [--seconds N] [--readers N]
+//
+//  Exit code is non-zero if the page can't be read or a check fails.
+// ============================================================================
+
+#include "MetricsPage.h"
+#include "Timing.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace MediumArmor;
+using MetricsPage::Page;
+using MetricsPage::Payload;
+
+namespace
+{
+    const char* kHookLabels[MetricsPage::kMaxHooks] =
+    {
+        "488CB0", "IsHeavy", "SkillAV", "CalcAR", "Trap", "GetDmg", "-", "-",
+    };
+
+    Page* MapSegment(const char* name, bool create)
+    {
+        const int fd = create ? shm_open(name, O_CREAT | O_RDWR, 0644) : shm_open(name, O_RDONLY, 0);
+        if (fd < 0)
+        {
+            std::perror(name);
+            return nullptr;
+        }
+
+        if (create && ftruncate(fd, sizeof(Page)) != 0)
+        {
+            std::perror("ftruncate");
+            close(fd);
+            return nullptr;
+        }
+
+        void* view = mmap(nullptr, sizeof(Page), create ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (view == MAP_FAILED)
+        {
+            std::perror("mmap");
+            return nullptr;
+        }
+        return static_cast<Page*>(view);
+    }
+
+    void Unmap(Page* page)
+    {
+        munmap(page, sizeof(Page));
+    }
+
+    double Pct(uint32_t hits, uint32_t misses)
+    {
+        return hits + misses ? 100.0 * hits / (hits + misses) : 0.0;
+    }
+
+    void PrintPayload(const Payload& p, const Payload* prev, double seconds)
+    {
+        std::printf("frame %u  skill %.2f (effective %.2f)  hook callouts %.1f us/frame (max %.1f)  "
+            "listeners %.1f us  warm-up pending %u\n",
+            p.frame, p.skill, p.effectiveSkill, p.frameCalloutNs / 1e3, p.frameCalloutMaxNs / 1e3,
+            p.listenerWorkNs / 1e3, p.warmUpPending);
+
+        std::printf("  hooks:");
+        for (uint32_t i = 0; i < p.hookCount && i < MetricsPage::kMaxHooks; ++i)
+        {
+            std::printf("  %s%s %u", kHookLabels[i], p.hookEnabled[i] ? "" : "(off)", p.hookCalls[i]);
+            if (prev && seconds > 0.0)
+                std::printf(" (%.0f/s)", (p.hookCalls[i] - prev->hookCalls[i]) / seconds);
+        }
+        std::printf("\n");
+
+        std::printf("  display AR %.1f%% of %u  wear counts %u",
+            Pct(p.arDisplayHits, p.arDisplayMisses), p.arDisplayHits + p.arDisplayMisses, p.wearCounts);
+        if (prev && seconds > 0.0)
+        {
+            const uint32_t counts = p.wearCounts - prev->wearCounts;
+            std::printf(" (%.0f/s, %.1f entries each)", counts / seconds,
+                counts ? static_cast<double>(p.wearEntries - prev->wearEntries) / counts : 0.0);
+        }
+        std::printf("\n");
+    }
+
+    int RunReader(const char* name, UInt32 intervalMs, bool once)
+    {
+        Page* page = MapSegment(name, false);
+        if (!page)
+            return 1;
+
+        Payload prev = {};
+        bool havePrev = false;
+        UInt64 prevAt = 0;
+
+        for (;;)
+        {
+            Payload now;
+            if (!MetricsPage::Read(page, now))
+            {
+                std::fprintf(stderr, "metricsreader: %s is not a version %u metrics page (or never settled)\n",
+                    name, MetricsPage::kVersion);
+                Unmap(page);
+                return 1;
+            }
+
+            const UInt64 at = Timing::NowNs();
+            PrintPayload(now, havePrev ? &prev : nullptr, (at - prevAt) / 1e9);
+            std::fflush(stdout);
+            if (once)
+                break;
+
+            prev = now;
+            prevAt = at;
+            havePrev = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+        }
+
+        Unmap(page);
+        return 0;
+    }
+
+    // Every field is a function of n, so a reader can tell a torn copy.
+    Payload MakePayload(uint32_t n)
+    {
+        Payload p = {};
+        p.frame = n;
+        p.publishCount = n;
+        p.hookCount = 6;
+        for (uint32_t i = 0; i < MetricsPage::kMaxHooks; ++i)
+        {
+            p.hookCalls[i] = n * (i + 3);
+            p.hookEnabled[i] = i < 6 ? 1 : 0;
+        }
+        p.arDisplayHits = n * 3;
+        p.arDisplayMisses = n / 2;
+        p.wearCounts = n * 5;
+        p.wearEntries = n * 160;
+        p.warmUpPending = n % 40;
+        p.skill = static_cast<float>(n % 10000) / 100.0f;
+        p.effectiveSkill = p.skill;
+        p.frameCalloutNs = 1000ull + n % 500;
+        p.frameCalloutMaxNs = 1499;
+        p.publishedAtNs = n * 16000000ull;
+        p.listenerWorkNs = 200ull + n % 300;
+        for (uint32_t i = 0; i < sizeof(p.reserved) / sizeof(p.reserved[0]); ++i)
+            p.reserved[i] = n ^ i;
+        return p;
+    }
+
+    bool IsConsistent(const Payload& p)
+    {
+        const Payload expected = MakePayload(p.frame);
+        return std::memcmp(&p, &expected, sizeof(Payload)) == 0;
+    }
+
+    int RunDemoWriter(const char* name, UInt32 seconds)
+    {
+        Page* page = MapSegment(name, true);
+        if (!page)
+            return 1;
+
+        MetricsPage::InitPage(page);
+        std::printf("metricsreader: publishing demo counters to %s for %u s\n", name, seconds);
+
+        const UInt64 end = Timing::NowNs() + seconds * 1000000000ull;
+        for (uint32_t n = 1; Timing::NowNs() < end; ++n)
+        {
+            Payload p = MakePayload(n);
+            p.publishedAtNs = Timing::NowNs();
+            MetricsPage::Publish(page, p);
+            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+        }
+
+        Unmap(page);
+        shm_unlink(name);
+        return 0;
+    }
+
+    int RunCheck(UInt32 seconds, UInt32 readers)
+    {
+        const std::string name = "/MediumArmorMetrics.check." + std::to_string(getpid());
+
+        Page* writerView = MapSegment(name.c_str(), true);
+        if (!writerView)
+            return 1;
+        MetricsPage::InitPage(writerView);
+        MetricsPage::Publish(writerView, MakePayload(0));
+
+        std::atomic<bool> stop = false;
+        std::atomic<UInt64> writes = 0;
+
+        struct ReaderResult
+        {
+            UInt64 reads = 0;
+            UInt64 gaveUp = 0;
+            UInt64 torn = 0;
+            UInt64 backwards = 0;
+        };
+        std::vector<ReaderResult> results(readers);
+
+        std::thread writer([&]
+            {
+                // Publish as fast as possible: far harsher than once a frame.
+                uint32_t n = 1;
+                while (!stop.load(std::memory_order_relaxed))
+                    MetricsPage::Publish(writerView, MakePayload(n++));
+                writes = n - 1;
+            });
+
+        std::vector<std::thread> threads;
+        bool mapped = true;
+        for (UInt32 r = 0; r < readers; ++r)
+        {
+            // A separate mapping per reader, as another process would have.
+            Page* view = MapSegment(name.c_str(), false);
+            if (!view)
+            {
+                mapped = false;
+                break;
+            }
+
+            threads.emplace_back([&, view, r]
+                {
+                    ReaderResult& out = results[r];
+                    uint32_t last = 0;
+                    while (!stop.load(std::memory_order_relaxed))
+                    {
+                        Payload p;
+                        if (!MetricsPage::Read(view, p, 1024))
+                        {
+                            ++out.gaveUp;
+                            continue;
+                        }
+                        ++out.reads;
+                        if (!IsConsistent(p))
+                            ++out.torn;
+                        if (p.frame < last)
+                            ++out.backwards;
+                        last = p.frame;
+                    }
+                    Unmap(view);
+                });
+        }
+
+        std::this_thread::sleep_for(std::chrono::seconds(seconds));
+        stop = true;
+        writer.join();
+        for (std::thread& t : threads)
+            t.join();
+
+        Unmap(writerView);
+        shm_unlink(name.c_str());
+
+        if (!mapped)
+            return 1;
+
+        // A single-threaded round trip through the real layout, too.
+        Page local;
+        MetricsPage::InitPage(&local);
+        Payload roundTrip;
+        MetricsPage::Publish(&local, MakePayload(12345));
+        const bool roundTripOk = MetricsPage::Read(&local, roundTrip) && IsConsistent(roundTrip) &&
+            local.sequence.load() == 2;
+
+        local.version = MetricsPage::kVersion + 1;
+        const bool versionRejected = !MetricsPage::Read(&local, roundTrip);
+
+        UInt64 reads = 0, gaveUp = 0, torn = 0, backwards = 0;
+        for (const ReaderResult& r : results)
+        {
+            reads += r.reads;
+            gaveUp += r.gaveUp;
+            torn += r.torn;
+            backwards += r.backwards;
+        }
+
+        std::printf("%s  round trip through Publish/Read\n", roundTripOk ? "ok  " : "FAIL");
+        std::printf("%s  wrong version rejected\n", versionRejected ? "ok  " : "FAIL");
+        std::printf("%s  %llu writes, %llu reads on %u readers: %llu torn accepted\n", torn ? "FAIL" : "ok  ",
+            static_cast<unsigned long long>(writes.load()), static_cast<unsigned long long>(reads), readers,
+            static_cast<unsigned long long>(torn));
+        std::printf("%s  frame never goes backwards for a reader (%llu)\n", backwards ? "FAIL" : "ok  ",
+            static_cast<unsigned long long>(backwards));
+        std::printf("      %llu reads gave up after 1024 retries (writer publishing nonstop)\n",
+            static_cast<unsigned long long>(gaveUp));
+
+        return roundTripOk && versionRejected && !torn && !backwards && reads ? 0 : 1;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const char* name = MetricsPage::kPosixName;
+    UInt32 intervalMs = 500;
+    UInt32 seconds = 0;
+    UInt32 readers = 3;
+    bool once = false;
+    bool demo = false;
+    bool check = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (!std::strcmp(arg, "--once"))                         once = true;
+        else if (!std::strcmp(arg, "--demo-writer"))             demo = true;
+        else if (!std::strcmp(arg, "--check"))                   check = true;
+        else if (!std::strcmp(arg, "--name") && hasValue)        name = argv[++i];
+        else if (!std::strcmp(arg, "--interval") && hasValue)    intervalMs = std::strtoul(argv[++i], nullptr, 10);
+        else if (!std::strcmp(arg, "--seconds") && hasValue)     seconds = std::strtoul(argv[++i], nullptr, 10);
+        else if (!std::strcmp(arg, "--readers") && hasValue)     readers = std::strtoul(argv[++i], nullptr, 10);
+        else
+        {
+            std::fprintf(stderr, "usage: see the header of tools/MetricsReader.cpp\n");
+            return 2;
+        }
+    }
+
+    if (check)
+        return RunCheck(seconds ? seconds : 2, readers ? readers : 1);
+    if (demo)
+        return RunDemoWriter(name, seconds ? seconds : 60);
+    return RunReader(name, intervalMs ? intervalMs : 500, once);
+}
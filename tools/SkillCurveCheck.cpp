@@ -0,0 +1,245 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - tools/SkillCurveCheck.cpp
+//
+//  Checks SkillCurve against reference curves evaluated in double: the
+//  default XP table against Config.h's formula, compiled linear, exp, pow
+//  and multi-segment curves at every skill point and between them, the
+//  floor and non-finite handling, Parse(), the level-cost guard and
+//  Advance().  Then times a table lookup against exact evaluation, per
+//  call.
+//
+//  Built without tools/ToolPrefix.h on purpose: SkillCurve.h and Config.h
+//  must compile on their own.
+//
+//  Build (Linux):
+//      g++ -O2 -std=c++20 -I. tools/SkillCurveCheck.cpp SkillCurve.cpp
+//          -o skillcurvecheck
+//
+//  Usage:
+//      skillcurvecheck [--calls N]
+//
+//  Exit code is non-zero if any check fails.
+// ============================================================================
+
+#include "SkillCurve.h"
+#include "Timing.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+
+namespace
+{
+    using namespace MediumArmor;
+    using SkillCurve::CurveDef;
+    using SkillCurve::Shape;
+    using SkillCurve::Table;
+
+    int s_failed = 0;
+
+    void Check(bool ok, const char* what)
+    {
+        std::printf("%s  %s\n", ok ? "ok  " : "FAIL", what);
+        if (!ok)
+            ++s_failed;
+    }
+
+    bool Near(double got, double want, double relTol)
+    {
+        return std::fabs(got - want) <= relTol * (std::fabs(want) > 1.0 ? std::fabs(want) : 1.0);
+    }
+
+    // Largest relative error of the table against `reference`, at every
+    // skill point and at the quarter points between them.
+    template <typename Reference>
+    double WorstError(const Table& table, Reference&& reference, bool between)
+    {
+        double worst = 0.0;
+        for (int i = 0; i <= 100 * 4; ++i)
+        {
+            if (!between && i % 4)
+                continue;
+            const double skill = i / 4.0;
+            const double want = reference(skill);
+            const double err = std::fabs(SkillCurve::Sample(table, static_cast<float>(skill)) - want)
+                / (std::fabs(want) > 1.0 ? std::fabs(want) : 1.0);
+            worst = err > worst ? err : worst;
+        }
+        return worst;
+    }
+
+    CurveDef Def(float floor, std::initializer_list<SkillCurve::Segment> segments)
+    {
+        CurveDef def = {};
+        def.floor = floor;
+        for (const SkillCurve::Segment& seg : segments)
+            def.segments[def.count++] = seg;
+        return def;
+    }
+
+    void CheckDefaults()
+    {
+        auto xp = [](double s)
+            {
+                const double factor = 1.0 - kXPSkillFactor * (s / 100.0);
+                return kXPPerHit * (factor > 0.05 ? factor : 0.05);
+            };
+        Check(WorstError(SkillCurve::kDefaultXPGain, xp, true) < 1e-6, "default XP table matches Config.h's formula");
+        Check(WorstError(SkillCurve::kDefaultLevelCost, [](double) { return 1.0; }, true) == 0.0,
+            "default level cost is 1 everywhere");
+
+        SkillCurve::ResetCurves();
+        Check(SkillCurve::XPGain(50.0f) == SkillCurve::Sample(SkillCurve::kDefaultXPGain, 50.0f)
+            && SkillCurve::LevelCost(50.0f) == 1.0f, "ResetCurves restores the defaults");
+
+        CurveDef def;
+        Table table;
+        Check(SkillCurve::Parse("0:linear:1:-0.005", 0.05f, def) && SkillCurve::Compile(def, table)
+            && WorstError(table, xp, true) < 1e-6, "the default written as a curve compiles to the same table");
+    }
+
+    void CheckShapes()
+    {
+        Table table;
+
+        // Linear interpolates exactly, between points too.
+        const CurveDef linear = Def(0.0f, { { 0.0f, Shape::Linear, 2.0f, 0.25f } });
+        Check(SkillCurve::Compile(linear, table)
+            && WorstError(table, [](double s) { return 2.0 + 0.25 * s; }, true) < 1e-6, "linear");
+
+        // Curved shapes are exact at skill points; between them the lerp
+        // error is bounded by the curvature over one point.
+        auto exp = [](double s) { return 0.5 * std::exp(0.03 * s); };
+        const CurveDef expDef = Def(0.0f, { { 0.0f, Shape::Exponential, 0.5f, 0.03f } });
+        Check(SkillCurve::Compile(expDef, table) && WorstError(table, exp, false) < 1e-6, "exp at skill points");
+        Check(WorstError(table, exp, true) < 2e-4, "exp between skill points");
+
+        auto pow = [](double s) { return 3.0 * std::pow(s, 1.5); };
+        const CurveDef powDef = Def(0.0f, { { 0.0f, Shape::Power, 3.0f, 1.5f } });
+        Check(SkillCurve::Compile(powDef, table) && WorstError(table, pow, false) < 1e-6, "pow at skill points");
+
+        // Flat to 25, linear to 75, exp above: each segment from its own start.
+        auto mixed = [](double s)
+            {
+                if (s < 25.0) return 1.0;
+                if (s < 75.0) return 0.5 + 0.02 * s;
+                return 0.1 * std::exp(0.03 * s);
+            };
+        const CurveDef mixedDef = Def(0.0f, {
+            { 0.0f,  Shape::Linear,      1.0f, 0.0f },
+            { 25.0f, Shape::Linear,      0.5f, 0.02f },
+            { 75.0f, Shape::Exponential, 0.1f, 0.03f } });
+        Check(SkillCurve::Compile(mixedDef, table) && WorstError(table, mixed, false) < 1e-6,
+            "multi-segment at skill points");
+        Check(Near(SkillCurve::Evaluate(mixedDef, 74.9f), 0.5 + 0.02 * 74.9, 1e-6)
+            && Near(SkillCurve::Evaluate(mixedDef, 75.0f), 0.1 * std::exp(2.25), 1e-6),
+            "a segment starts exactly at its fromSkill");
+
+        Check(SkillCurve::Sample(table, -5.0f) == table.v[0] && SkillCurve::Sample(table, 250.0f) == table.v[100]
+            && SkillCurve::Sample(table, NAN) == table.v[0], "samples clamp to 0..100, NaN to 0");
+    }
+
+    void CheckFloor()
+    {
+        const CurveDef falling = Def(0.2f, { { 0.0f, Shape::Linear, 1.0f, -0.01f } });
+        Check(SkillCurve::Evaluate(falling, 10.0f) == 0.9f && SkillCurve::Evaluate(falling, 90.0f) == 0.2f,
+            "results are clamped to the floor");
+
+        // 1 / s at s = 0 is infinite.
+        const CurveDef inverse = Def(0.1f, { { 0.0f, Shape::Power, 1.0f, -1.0f } });
+        Check(SkillCurve::Evaluate(inverse, 0.0f) == 0.1f && Near(SkillCurve::Evaluate(inverse, 4.0f), 0.25, 1e-6),
+            "a non-finite result becomes the floor");
+    }
+
+    void CheckCompileAndParse()
+    {
+        Table table;
+        Check(!SkillCurve::Compile(Def(0.0f, {}), table), "an empty curve does not compile");
+        Check(!SkillCurve::Compile(Def(0.0f, { { 5.0f, Shape::Linear, 1.0f, 0.0f } }), table),
+            "a curve not starting at 0 does not compile");
+        Check(!SkillCurve::Compile(Def(0.0f, {
+            { 0.0f,  Shape::Linear, 1.0f, 0.0f },
+            { 50.0f, Shape::Linear, 1.0f, 0.0f },
+            { 50.0f, Shape::Linear, 2.0f, 0.0f } }), table), "segments must ascend");
+
+        CurveDef def;
+        Check(SkillCurve::Parse(" 0:linear:1:0.5 ; 40:exp:0.2:0.04;80:pow:0.01:2 ", 0.0f, def) && def.count == 3
+            && def.segments[1].shape == Shape::Exponential && def.segments[2].fromSkill == 80.0f
+            && def.segments[2].b == 2.0f, "parse reads every segment, spaces allowed");
+
+        const char* bad[] = { "", "0:linear:1", "0:cubic:1:2", "0:linear:1:2 x", "0;linear;1;2",
+            "0:linear:1:0;1:linear:1:0;2:linear:1:0;3:linear:1:0;4:linear:1:0;5:linear:1:0;6:linear:1:0;"
+            "7:linear:1:0;8:linear:1:0" };
+        bool rejected = !SkillCurve::Parse(nullptr, 0.0f, def);
+        for (const char* text : bad)
+            rejected &= !SkillCurve::Parse(text, 0.0f, def);
+        Check(rejected, "parse rejects malformed text and too many segments");
+
+        // Advance divides by the level cost.
+        Check(!SkillCurve::SetLevelCostCurve(Def(0.0f, { { 0.0f, Shape::Linear, 1.0f, -0.02f } }))
+            && SkillCurve::LevelCost(100.0f) == 1.0f, "a level cost reaching 0 is refused and the old table kept");
+        Check(SkillCurve::SetLevelCostCurve(Def(0.0f, { { 0.0f, Shape::Linear, 1.0f, 0.01f } }))
+            && SkillCurve::LevelCost(100.0f) == 2.0f, "a positive level cost is taken");
+        Check(SkillCurve::Advance(50.0f, 3.0f) == 50.0f + 3.0f / 1.5f && SkillCurve::Advance(99.0f, 5.0f) == 100.0f,
+            "advance adds xp / level cost, up to 100");
+        SkillCurve::ResetCurves();
+        Check(SkillCurve::Advance(50.0f, 3.0f) == 53.0f && SkillCurve::Advance(0.5f, -1.0f) == 0.0f,
+            "advance at the default cost, down to 0");
+    }
+
+    void Benchmark(uint32_t calls)
+    {
+        const CurveDef def = Def(0.05f, {
+            { 0.0f,  Shape::Power,       0.8f, 0.3f },
+            { 50.0f, Shape::Exponential, 3.0f, -0.02f } });
+        SkillCurve::SetXPGainCurve(def);
+
+        // Skills step by an odd fraction so every table slot and lerp
+        // weight is exercised and nothing folds to a constant.
+        volatile float sink = 0.0f;
+        float skill = 0.0f;
+        uint64_t t0 = Timing::NowNs();
+        for (uint32_t i = 0; i < calls; ++i)
+        {
+            sink = sink + SkillCurve::XPGain(skill);
+            skill = skill < 100.0f ? skill + 0.37f : 0.0f;
+        }
+        const uint64_t tableNs = Timing::NowNs() - t0;
+
+        skill = 0.0f;
+        t0 = Timing::NowNs();
+        for (uint32_t i = 0; i < calls; ++i)
+        {
+            sink = sink + SkillCurve::Evaluate(def, skill);
+            skill = skill < 100.0f ? skill + 0.37f : 0.0f;
+        }
+        const uint64_t exactNs = Timing::NowNs() - t0;
+        SkillCurve::ResetCurves();
+
+        std::printf("\n%u calls: table %.2f ns/call, exact %.2f ns/call (%.1fx)\n", calls,
+            static_cast<double>(tableNs) / calls, static_cast<double>(exactNs) / calls,
+            tableNs ? static_cast<double>(exactNs) / tableNs : 0.0);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t calls = 10000000;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--calls") == 0 && i + 1 < argc)
+            calls = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    }
+
+    CheckDefaults();
+    CheckShapes();
+    CheckFloor();
+    CheckCompileAndParse();
+    if (calls)
+        Benchmark(calls);
+
+    std::printf("\n%d failed\n", s_failed);
+    return s_failed ? 1 : 0;
+}
@@ -0,0 +1,166 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - tools/SkillSyncCheck.cpp
+//
+//  Checks SkillSync::Syncer against a fake UI backend that counts pushes.
+//  The plugin drives Flush() from the FrameClock timer once per frame;
+//  here the frames are a plain counter.
+//
+//      - a single change reaches the UI on the next frame, not the same one
+//      - changes within a frame coalesce into one push of the last value
+//      - an unchanged skill, or one changed back to what the UI shows,
+//        pushes nothing
+//      - a pull adopts the UI's value without pushing it back
+//      - binding a backend pushes the current value once
+//
+//  Build (Linux):
+//      g++ -O2 -std=c++20 -include tools/ToolPrefix.h -I.
+//          tools/SkillSyncCheck.cpp -o skillsynccheck
+//
+//  Exit code is non-zero if any check fails.
+// ============================================================================
+
+#include "SkillSync.h"
+
+namespace
+{
+    using MediumArmor::SkillSync::Syncer;
+    using MediumArmor::SkillSync::UIBackend;
+
+    int s_failed = 0;
+
+    void Check(bool ok, const char* what)
+    {
+        std::printf("%s  %s\n", ok ? "ok  " : "FAIL", what);
+        if (!ok)
+            ++s_failed;
+    }
+
+    class CountingBackend : public UIBackend
+    {
+    public:
+        void Push(float effectiveSkill) override
+        {
+            ++pushes;
+            shown = effectiveSkill;
+        }
+
+        bool Pull(float& outSkill) override
+        {
+            if (!pullable)
+                return false;
+            outSkill = shown;
+            return true;
+        }
+
+        uint32_t pushes = 0;
+        float    shown = 0.0f;
+        bool     pullable = true;
+    };
+
+    // Runs the frame driver from `from` up to and including `to`.
+    uint32_t RunFrames(Syncer& syncer, uint32_t from, uint32_t to)
+    {
+        uint32_t pushed = 0;
+        for (uint32_t frame = from; frame <= to; ++frame)
+            pushed += syncer.Flush(frame) ? 1 : 0;
+        return pushed;
+    }
+
+    void CheckSingleChange()
+    {
+        CountingBackend ui;
+        Syncer syncer(&ui);
+
+        syncer.NotifyChanged(42.0f, 10);
+        Check(!syncer.Flush(10) && ui.pushes == 0, "no push in the frame the change happened in");
+        Check(syncer.Flush(11) && ui.pushes == 1 && ui.shown == 42.0f, "a single change is pushed on the next frame");
+        Check(RunFrames(syncer, 12, 100) == 0 && ui.pushes == 1, "and only once");
+    }
+
+    void CheckCoalescing()
+    {
+        CountingBackend ui;
+        Syncer syncer(&ui);
+        syncer.NotifyChanged(10.0f, 1);
+        RunFrames(syncer, 1, 2);
+        ui.pushes = 0;
+
+        const uint32_t version = syncer.GetVersion();
+        for (int i = 1; i <= 50; ++i)
+            syncer.NotifyChanged(10.0f + i * 0.5f, 5);
+        Check(syncer.GetVersion() == version + 50, "every change bumps the version");
+        Check(RunFrames(syncer, 5, 8) == 1 && ui.pushes == 1 && ui.shown == 35.0f,
+            "changes within a frame coalesce into one push of the last value");
+
+        // A change in frame 9 while frame 8's is still pending keeps the
+        // earlier dirty frame: it goes out at frame 9, not 10.
+        syncer.NotifyChanged(36.0f, 8);
+        syncer.NotifyChanged(37.0f, 9);
+        Check(syncer.Flush(9) && ui.shown == 37.0f, "a pending change is not held back by a newer one");
+    }
+
+    void CheckNoOps()
+    {
+        CountingBackend ui;
+        Syncer syncer(&ui);
+        syncer.NotifyChanged(20.0f, 1);
+        RunFrames(syncer, 1, 2);
+        ui.pushes = 0;
+
+        const uint32_t version = syncer.GetVersion();
+        syncer.NotifyChanged(20.0f, 3);
+        Check(syncer.GetVersion() == version && !syncer.IsDirty(), "an unchanged skill is not a change");
+
+        syncer.NotifyChanged(21.0f, 4);
+        syncer.NotifyChanged(20.0f, 4);
+        Check(!syncer.IsDirty() && RunFrames(syncer, 4, 10) == 0 && ui.pushes == 0,
+            "a skill changed back to what the UI shows pushes nothing");
+    }
+
+    void CheckPull()
+    {
+        CountingBackend ui;
+        ui.shown = 55.0f;
+        Syncer syncer(&ui);
+
+        float pulled = 0.0f;
+        Check(syncer.Pull(pulled) && pulled == 55.0f && syncer.GetPullCount() == 1, "pull reads the UI's value");
+        Check(RunFrames(syncer, 1, 10) == 0 && ui.pushes == 0, "a pulled value is not pushed back");
+
+        syncer.NotifyChanged(55.0f, 11);
+        Check(RunFrames(syncer, 11, 20) == 0, "notifying the pulled value is a no-op");
+
+        ui.pullable = false;
+        syncer.NotifyChanged(56.0f, 21);
+        Check(!syncer.Pull(pulled) && syncer.IsDirty(), "a failed pull leaves the pending change alone");
+        Check(syncer.Flush(22) && ui.shown == 56.0f, "... which still goes out");
+    }
+
+    void CheckBinding()
+    {
+        Syncer syncer;
+        syncer.NotifyChanged(30.0f, 1);
+        Check(RunFrames(syncer, 1, 10) == 0, "nothing is pushed without a backend");
+
+        CountingBackend ui;
+        syncer.SetBackend(&ui);
+        Check(syncer.Flush(10) && ui.pushes == 1 && ui.shown == 30.0f, "binding a backend pushes the current value");
+        Check(RunFrames(syncer, 11, 20) == 0 && syncer.GetPushCount() == 1, "... once");
+
+        CountingBackend other;
+        syncer.SetBackend(&other);
+        Check(syncer.Flush(21) && other.pushes == 1 && other.shown == 30.0f, "rebinding pushes to the new backend");
+    }
+}
+
+int main()
+{
+    CheckSingleChange();
+    CheckCoalescing();
+    CheckNoOps();
+    CheckPull();
+    CheckBinding();
+
+    std::printf("\n%d failed\n", s_failed);
+    return s_failed ? 1 : 0;
+}
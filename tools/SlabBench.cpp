@@ -0,0 +1,299 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - tools/SlabBench.cpp
+//
+//  Checks SlabPool's handle rules, then times it against plain new/delete
+//  under cell churn: each simulated transition attaches a cell of actors,
+//  touches every live record a few times, and detaches the oldest cell.
+//  The pool reclaims a cell with one ReleaseTag(); the heap side deletes the
+//  cell's records one by one.
+//
+//  Build (Linux):
+//      g++ -O2 -std=c++20 -include tools/ToolPrefix.h -I.
+//          tools/SlabBench.cpp -o slabbench
+//
+//  Usage:
+//      slabbench [--transitions N] [--actors N] [--loaded N] [--touches N]
+//
+//  Exit code is non-zero if any check fails.
+// ============================================================================
+
+#include "SlabPool.h"
+#include "Timing.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+namespace
+{
+    using MediumArmor::SlabPool;
+
+    // Same shape as ARCache's actor record.
+    struct Record
+    {
+        UInt32 refID;
+        UInt32 skillVersion;
+        UInt32 luck;
+        const void* cell;
+        UInt32 pieceCount;
+        UInt32 nextReplace;
+        UInt32 pieces[8][4];
+    };
+
+    typedef SlabPool<Record, 64, 256> Pool;
+
+    // Counts the destructor so bulk release can be checked.
+    struct Tracked
+    {
+        static int s_alive;
+        UInt32 value;
+
+        explicit Tracked(UInt32 v) : value(v) { ++s_alive; }
+        ~Tracked() { --s_alive; }
+    };
+    int Tracked::s_alive = 0;
+
+    UInt32 s_failed = 0;
+
+    void Check(bool ok, const char* what)
+    {
+        std::printf("%s  %s\n", ok ? "ok  " : "FAIL", what);
+        if (!ok)
+            ++s_failed;
+    }
+
+    void RunChecks()
+    {
+        SlabPool<Tracked, 4, 2> pool;
+
+        const auto a = pool.Alloc(1, 10u);
+        const auto b = pool.Alloc(1, 20u);
+        const auto c = pool.Alloc(2, 30u);
+        Check(!a.IsNull() && !b.IsNull() && !c.IsNull(), "alloc returns non-null handles");
+        Check(pool.Get(b) && pool.Get(b)->value == 20, "get resolves a live handle");
+
+        Check(pool.Free(a), "free of a live handle succeeds");
+        Check(!pool.Get(a), "freed handle resolves to null");
+        Check(!pool.Free(a), "double free is rejected");
+
+        const auto a2 = pool.Alloc(1, 11u);
+        Check((a2.bits & 0xFFFF) == (a.bits & 0xFFFF), "freed slot is reused first");
+        Check(a2 != a && !pool.Get(a), "reused slot gets a new generation; old handle stays dead");
+        Check(pool.Get(a2) && pool.Get(a2)->value == 11, "new handle sees the new record");
+
+        Check(pool.ReleaseTag(1) == 2, "release by tag frees exactly the tagged records");
+        Check(!pool.Get(a2) && !pool.Get(b) && pool.Get(c), "other tags survive a tag release");
+
+        Check(pool.Retag(c, 3) && pool.ReleaseAllExcept(3) == 0 && pool.Get(c), "retag moves a record to its new owner");
+        Check(pool.ReleaseAllExcept(4) == 1 && !pool.Get(c), "release-all-except frees the rest");
+        Check(Tracked::s_alive == 0, "every released record is destroyed");
+
+        // A detached cell (7) whose record 71 followed the player into cell 8.
+        const auto stay = pool.Alloc(8, 80u);
+        const auto gone = pool.Alloc(7, 70u);
+        const auto follower = pool.Alloc(7, 71u);
+        const UInt32 released = pool.ReleaseOrRetag([](uintptr_t tag, Tracked& t) -> uintptr_t
+            {
+                return tag != 7 ? tag : t.value == 71 ? 8 : 0;
+            });
+        Check(released == 1 && !pool.Get(gone) && pool.Get(stay) && pool.Get(follower),
+            "release-or-retag frees only what the owner callback drops");
+        Check(pool.ReleaseTag(8) == 2 && Tracked::s_alive == 0, "retagged records move to the new owner");
+
+        std::vector<decltype(pool)::Handle> handles;
+        for (UInt32 i = 0; i < decltype(pool)::kCapacity; ++i)
+            handles.push_back(pool.Alloc(5, i));
+        Check(pool.Alloc(5, 0u).IsNull() && pool.GetStats().failedAllocs == 1, "a full pool returns a null handle");
+        Check(pool.GetStats().slabs == 2, "slabs are only allocated on demand");
+
+        decltype(pool)::Handle null = { 0 };
+        Check(!pool.Get(null) && !pool.Free(null), "null handle never resolves");
+
+        // Cycle one slot through a full generation wrap.
+        pool.Reset();
+        auto h = pool.Alloc(6, 0u);
+        const auto first = h;
+        for (UInt32 i = 0; i < 0xFFFF; ++i)
+        {
+            pool.Free(h);
+            h = pool.Alloc(6, i);
+        }
+        Check((h.bits >> 16) != 0 && pool.Get(h), "generation skips zero on wrap");
+        Check(h == first, "generation wraps after 65535 reuses (documented limit)");
+
+        pool.Reset();
+        Check(Tracked::s_alive == 0 && pool.GetStats().slabs == 0, "reset destroys records and frees slabs");
+    }
+
+    struct Options
+    {
+        UInt32 transitions = 20000;
+        UInt32 actors = 40;     // per cell
+        UInt32 loaded = 6;      // cells attached at once
+        UInt32 touches = 4;     // lookups per live record per transition
+    };
+
+    UInt64 s_sink = 0;
+
+    struct Timings
+    {
+        UInt64 churnNs;     // attach + detach
+        UInt64 accessNs;    // touches
+    };
+
+    Timings BenchPool(const Options& opt)
+    {
+        Pool pool;
+        std::deque<std::vector<Pool::Handle>> cells;
+        Timings time = {};
+
+        for (UInt32 t = 0; t < opt.transitions; ++t)
+        {
+            const UInt64 t0 = MediumArmor::Timing::NowNs();
+            const uintptr_t tag = t + 1;
+            std::vector<Pool::Handle>& cell = cells.emplace_back();
+            cell.reserve(opt.actors);
+            for (UInt32 i = 0; i < opt.actors; ++i)
+            {
+                const Pool::Handle h = pool.Alloc(tag);
+                if (Record* r = pool.Get(h))
+                    r->refID = t * opt.actors + i;
+                cell.push_back(h);
+            }
+
+            const UInt64 t1 = MediumArmor::Timing::NowNs();
+            for (UInt32 k = 0; k < opt.touches; ++k)
+            {
+                for (const auto& c : cells)
+                {
+                    for (const Pool::Handle h : c)
+                    {
+                        if (Record* r = pool.Get(h))
+                            s_sink += r->refID;
+                    }
+                }
+            }
+
+            const UInt64 t2 = MediumArmor::Timing::NowNs();
+            if (cells.size() > opt.loaded)
+            {
+                pool.ReleaseTag(t + 1 - opt.loaded);
+                cells.pop_front();
+            }
+            const UInt64 t3 = MediumArmor::Timing::NowNs();
+
+            time.churnNs += (t1 - t0) + (t3 - t2);
+            time.accessNs += t2 - t1;
+        }
+
+        const MediumArmor::SlabPoolStats& stats = pool.GetStats();
+        std::printf("  pool: peak %u records in %u slabs, %u allocs, %u bulk-released\n",
+            stats.peak, stats.slabs, stats.allocs, stats.bulkReleased);
+        return time;
+    }
+
+    Timings BenchHeap(const Options& opt)
+    {
+        std::deque<std::vector<Record*>> cells;
+        Timings time = {};
+
+        for (UInt32 t = 0; t < opt.transitions; ++t)
+        {
+            const UInt64 t0 = MediumArmor::Timing::NowNs();
+            std::vector<Record*>& cell = cells.emplace_back();
+            cell.reserve(opt.actors);
+            for (UInt32 i = 0; i < opt.actors; ++i)
+            {
+                Record* r = new Record();
+                r->refID = t * opt.actors + i;
+                cell.push_back(r);
+            }
+
+            const UInt64 t1 = MediumArmor::Timing::NowNs();
+            for (UInt32 k = 0; k < opt.touches; ++k)
+            {
+                for (const auto& c : cells)
+                {
+                    for (const Record* r : c)
+                        s_sink += r->refID;
+                }
+            }
+
+            const UInt64 t2 = MediumArmor::Timing::NowNs();
+            if (cells.size() > opt.loaded)
+            {
+                for (Record* r : cells.front())
+                    delete r;
+                cells.pop_front();
+            }
+            const UInt64 t3 = MediumArmor::Timing::NowNs();
+
+            time.churnNs += (t1 - t0) + (t3 - t2);
+            time.accessNs += t2 - t1;
+        }
+
+        for (auto& c : cells)
+        {
+            for (Record* r : c)
+                delete r;
+        }
+        return time;
+    }
+
+    bool ParseUInt(const char* text, UInt32& out)
+    {
+        char* end = nullptr;
+        const unsigned long v = std::strtoul(text, &end, 10);
+        if (!end || *end || v == 0)
+            return false;
+        out = static_cast<UInt32>(v);
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    for (int i = 1; i < argc; ++i)
+    {
+        UInt32* target = nullptr;
+        if (!std::strcmp(argv[i], "--transitions"))  target = &opt.transitions;
+        else if (!std::strcmp(argv[i], "--actors"))  target = &opt.actors;
+        else if (!std::strcmp(argv[i], "--loaded"))  target = &opt.loaded;
+        else if (!std::strcmp(argv[i], "--touches")) target = &opt.touches;
+
+        if (!target || i + 1 == argc || !ParseUInt(argv[++i], *target))
+        {
+            std::fprintf(stderr, "usage: slabbench [--transitions N] [--actors N] [--loaded N] [--touches N]\n");
+            return 2;
+        }
+    }
+
+    if (opt.actors * (opt.loaded + 1) > Pool::kCapacity)
+    {
+        std::fprintf(stderr, "actors * (loaded + 1) must not exceed %u\n", Pool::kCapacity);
+        return 2;
+    }
+
+    RunChecks();
+
+    std::printf("\nchurn: %u transitions, %u actors per cell, %u cells loaded, %u touches\n",
+        opt.transitions, opt.actors, opt.loaded, opt.touches);
+
+    const Timings pool = BenchPool(opt);
+    const Timings heap = BenchHeap(opt);
+    const double records = static_cast<double>(opt.transitions) * opt.actors;
+    const double accesses = records * opt.touches * opt.loaded;
+
+    std::printf("               alloc+release (per record)   access (per lookup)\n");
+    std::printf("  SlabPool     %9.2f ms (%6.1f ns)     %9.2f ms (%5.2f ns)\n",
+        pool.churnNs / 1e6, pool.churnNs / records, pool.accessNs / 1e6, pool.accessNs / accesses);
+    std::printf("  new/delete   %9.2f ms (%6.1f ns)     %9.2f ms (%5.2f ns)\n",
+        heap.churnNs / 1e6, heap.churnNs / records, heap.accessNs / 1e6, heap.accessNs / accesses);
+    std::printf("  (sink %llu)\n", static_cast<unsigned long long>(s_sink));
+
+    if (s_failed)
+        std::printf("\n%u check(s) failed\n", s_failed);
+    return s_failed ? 1 : 0;
+}
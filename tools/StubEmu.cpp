@@ -0,0 +1,1126 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - tools/StubEmu.cpp
+//
+//  Runs the naked detour stubs from Hooks.cpp and Patches.cpp on a small
+//  x86-32 interpreter, so stack and register handling can be checked off
+//  the game.  Each stub is re-assembled here instruction for instruction
+//  (keep them in step with the __asm blocks; --dump prints the bytes for a
+//  side-by-side with an MSVC /FAs listing).  Globals live at fixed
+//  addresses, callees are native C++ stand-ins that clobber the volatile
+//  registers like real cdecl code, and every scenario reports the exit
+//  path, registers, stack delta and instruction count.  For mid-function
+//  sites it also checks the patch footprint: the expected bytes cover the
+//  whole jmp, the stub replays them, and it resumes right after them.
+//
+//  Only the instruction subset the stubs use is decoded; anything else
+//  stops the run with "unsupported opcode".
+//
+//  Build (Linux):
+//      g++ -O2 -std=c++20 -include tools/ToolPrefix.h -I.
+//          tools/StubEmu.cpp -o stubemu
+//
+//  Usage:
+//      stubemu [--dump] [--verbose]
+//
+//  Exit code is non-zero if any scenario fails.
+// ============================================================================
+
+#include <algorithm>
+#include <array>
+#include <cstdarg>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    // ── Memory map ─────────────────────────────────────────────────────────
+    constexpr UInt32 kHookCalls = 0x00100000;   // g_hookCalls[6]
+    constexpr UInt32 kHookEnabled = 0x00100040;   // g_hookEnabled[6]
+
+    constexpr UInt32 kFnIsMedium_Sub488CB0 = 0x00100080;
+    constexpr UInt32 kFnIsMedium_IsHeavyArmor = 0x00100084;
+    constexpr UInt32 kFnIsMedium_GetArmorSkillAV = 0x00100088;
+    constexpr UInt32 kFnCalcMediumPieceAR = 0x0010008C;
+    constexpr UInt32 kResumeAddr_488CB0 = 0x00100090;
+    constexpr UInt32 kResumeAddr_CalcAR = 0x00100094;
+    constexpr UInt32 kFnCachedCalcAR = 0x0010009C;
+    constexpr UInt32 kMediumArmorFlag = 0x001000B0;
+    constexpr UInt32 kMediumArmorForm = 0x001000B4;
+
+    constexpr UInt32 kCodeBase = 0x00200000;
+    constexpr UInt32 kStackTop = 0x00300000;
+    constexpr UInt32 kObjectBase = 0x00400000;
+    constexpr UInt32 kTrampoline_CalcAR = 0x00700000;
+    constexpr UInt32 kNativeBase = 0xFE000000;
+    constexpr UInt32 kReturnSentinel = 0xEEEE0000;
+
+    // Game addresses the stubs reference directly.
+    constexpr UInt32 kFloatConst_488CB0 = 0x00A30634;
+    constexpr UInt32 kSite_488CB0 = 0x00488CB0;
+    constexpr UInt32 kResume_488CB0 = 0x00488CB9;
+    constexpr UInt32 kTrap_Site = 0x005ED1F8;
+    constexpr UInt32 kTrap_Safe = 0x005ED21D;
+    constexpr UInt32 kTrap_Resume = 0x005ED1FE;
+    constexpr UInt32 kGetDamage_Site = 0x00484F99;
+    constexpr UInt32 kGetDamage_Resume = 0x00484F9E;
+
+    constexpr UInt32 kMaxSteps = 10000;
+
+    enum Reg : UInt32 { EAX, ECX, EDX, EBX, ESP, EBP, ESI, EDI };
+    const char* kRegNames[8] = { "eax", "ecx", "edx", "ebx", "esp", "ebp", "esi", "edi" };
+
+    // ── Assembler: just enough encodings for the stubs ─────────────────────
+    class Asm
+    {
+    public:
+        std::vector<UInt8> bytes;
+
+        void Label(const char* name) { m_labels[name] = Here(); }
+
+        void IncMem32(UInt32 addr)               { Op({ 0xFF, 0x05 }); Imm32(addr); }
+        void CmpMem8(UInt32 addr, UInt8 imm)     { Op({ 0x80, 0x3D }); Imm32(addr); Imm8(imm); }
+        void MovMem8(UInt32 addr, UInt8 imm)     { Op({ 0xC6, 0x05 }); Imm32(addr); Imm8(imm); }
+        void CallMem(UInt32 addr)                { Op({ 0xFF, 0x15 }); Imm32(addr); }
+        void JmpMem(UInt32 addr)                 { Op({ 0xFF, 0x25 }); Imm32(addr); }
+        void JmpReg(Reg r)                       { Op({ 0xFF, static_cast<UInt8>(0xE0 | r) }); }
+        void FldMem32(UInt32 addr)               { Op({ 0xD9, 0x05 }); Imm32(addr); }
+        void FstpMem32(UInt32 addr)              { Op({ 0xD9, 0x1D }); Imm32(addr); }
+        void FldBaseDisp32(Reg base, UInt32 d)   { Op({ 0xD9, static_cast<UInt8>(0x80 | base) }); Imm32(d); }
+        void MovEaxMem(UInt32 addr)              { Op({ 0xA1 }); Imm32(addr); }
+        void MovRegImm(Reg r, UInt32 imm)        { Op({ static_cast<UInt8>(0xB8 + r) }); Imm32(imm); }
+        void MovR8BaseDisp8(Reg dst, Reg base, UInt8 d) { Op({ 0x8A, ModRM(1, dst, base) }); Imm8(d); }
+        void MovR32BaseDisp8(Reg dst, Reg base, UInt8 d) { Op({ 0x8B, ModRM(1, dst, base) }); Imm8(d); }
+        void MovEspDisp8Reg(UInt8 d, Reg src)    { Op({ 0x89, ModRM(1, src, ESP), 0x24 }); Imm8(d); }
+        void MovMemReg(UInt32 addr, Reg src)     { Op({ 0x89, ModRM(0, src, EBP) }); Imm32(addr); }
+        void PushEspDisp8(UInt8 d)               { Op({ 0xFF, 0x74, 0x24 }); Imm8(d); }
+        void PushImm(UInt32 imm)                 { Op({ 0x68 }); Imm32(imm); }
+        void Push(Reg r)                         { Op({ static_cast<UInt8>(0x50 + r) }); }
+        void Pop(Reg r)                          { Op({ static_cast<UInt8>(0x58 + r) }); }
+        void Pushad()                            { Op({ 0x60 }); }
+        void Popad()                             { Op({ 0x61 }); }
+        void AddReg(Reg r, UInt8 imm)            { Op({ 0x83, static_cast<UInt8>(0xC0 | r), imm }); }
+        void SubReg(Reg r, UInt8 imm)            { Op({ 0x83, static_cast<UInt8>(0xE8 | r), imm }); }
+        void AndRegImm8(Reg r, UInt8 imm)        { Op({ 0x83, static_cast<UInt8>(0xE0 | r), imm }); }
+        void AndAl(UInt8 imm)                    { Op({ 0x24, imm }); }
+        void CmpAl(UInt8 imm)                    { Op({ 0x3C, imm }); }
+        void TestR8(Reg a, Reg b)                { Op({ 0x84, ModRM(3, b, a) }); }
+        void TestR32(Reg a, Reg b)               { Op({ 0x85, ModRM(3, b, a) }); }
+        void XorR8(Reg a, Reg b)                 { Op({ 0x32, ModRM(3, a, b) }); }
+        void SbbR32(Reg a, Reg b)                { Op({ 0x1B, ModRM(3, a, b) }); }
+        void NegR8(Reg r)                        { Op({ 0xF6, static_cast<UInt8>(0xD8 | r) }); }
+        void ShrR8(Reg r, UInt8 imm)             { Op({ 0xC0, static_cast<UInt8>(0xE8 | r), imm }); }
+        void Ret()                               { Op({ 0xC3 }); }
+        void Ret(UInt16 imm)                     { Op({ 0xC2 }); Imm8(imm & 0xFF); Imm8(imm >> 8); }
+
+        void Jz(const char* label)  { Jump(0x74, label); }
+        void Jnz(const char* label) { Jump(0x75, label); }
+
+        bool Link()
+        {
+            for (const Fixup& f : m_fixups)
+            {
+                auto it = m_labels.find(f.label);
+                if (it == m_labels.end())
+                    return false;
+                const SInt32 rel = static_cast<SInt32>(it->second) - static_cast<SInt32>(f.at + 1);
+                if (rel < -128 || rel > 127)
+                    return false;
+                bytes[f.at] = static_cast<UInt8>(rel);
+            }
+            return true;
+        }
+
+    private:
+        struct Fixup
+        {
+            UInt32      at;
+            std::string label;
+        };
+
+        UInt32 Here() const { return static_cast<UInt32>(bytes.size()); }
+        void Op(std::initializer_list<UInt8> b) { bytes.insert(bytes.end(), b); }
+        void Imm8(UInt32 v) { bytes.push_back(static_cast<UInt8>(v)); }
+        void Imm32(UInt32 v) { for (int i = 0; i < 4; ++i) bytes.push_back(static_cast<UInt8>(v >> (8 * i))); }
+        static UInt8 ModRM(UInt8 mod, UInt32 reg, UInt32 rm) { return static_cast<UInt8>((mod << 6) | (reg << 3) | rm); }
+
+        void Jump(UInt8 opcode, const char* label)
+        {
+            Op({ opcode });
+            m_fixups.push_back({ Here(), label });
+            Imm8(0);
+        }
+
+        std::map<std::string, UInt32> m_labels;
+        std::vector<Fixup>            m_fixups;
+    };
+
+    // ── Stubs (mirror Hooks.cpp / Patches.cpp) ─────────────────────────────
+    Asm Build_Detour_IsHeavyArmor()
+    {
+        Asm a;
+        a.IncMem32(kHookCalls + 4 * 1);
+        a.CmpMem8(kHookEnabled + 1, 0);
+        a.Jz("not_medium");
+        a.Push(ECX);
+        a.Push(ECX);
+        a.CallMem(kFnIsMedium_IsHeavyArmor);
+        a.AddReg(ESP, 4);
+        a.TestR8(EAX, EAX);
+        a.Pop(ECX);
+        a.Jnz("is_medium");
+        a.Label("not_medium");
+        a.MovR8BaseDisp8(EAX, ECX, 0x6A);
+        a.ShrR8(EAX, 7);
+        a.Ret();
+        a.Label("is_medium");
+        a.XorR8(EAX, EAX);
+        a.Ret();
+        return a;
+    }
+
+    Asm Build_Detour_GetArmorSkillAV()
+    {
+        Asm a;
+        a.IncMem32(kHookCalls + 4 * 2);
+        a.CmpMem8(kHookEnabled + 2, 0);
+        a.Jz("not_medium");
+        a.Push(ECX);
+        a.Push(ECX);
+        a.CallMem(kFnIsMedium_GetArmorSkillAV);
+        a.AddReg(ESP, 4);
+        a.TestR8(EAX, EAX);
+        a.Pop(ECX);
+        a.Jnz("medium_skill");
+        a.Label("not_medium");
+        a.MovR8BaseDisp8(EAX, ECX, 0x6A);
+        a.AndAl(0x80);
+        a.NegR8(EAX);
+        a.SbbR32(EAX, EAX);
+        a.AndRegImm8(EAX, 0xF7);
+        a.AddReg(EAX, 0x1B);
+        a.Ret();
+        a.Label("medium_skill");
+        a.MovMem8(kMediumArmorFlag, 1);
+        a.MovMemReg(kMediumArmorForm, ECX);
+        a.MovRegImm(EAX, 0x1B);
+        a.Ret();
+        return a;
+    }
+
+    Asm Build_Detour_CalcArmorRating()
+    {
+        Asm a;
+        a.IncMem32(kHookCalls + 4 * 3);
+        a.CmpMem8(kHookEnabled + 3, 0);
+        a.Jz("disabled");
+        a.CmpMem8(kMediumArmorFlag, 0);
+        a.Jz("vanilla");
+        a.MovMem8(kMediumArmorFlag, 0);
+        a.JmpMem(kFnCachedCalcAR);
+        a.Label("disabled");
+        a.MovMem8(kMediumArmorFlag, 0);
+        a.Label("vanilla");
+        a.JmpMem(kResumeAddr_CalcAR);
+        return a;
+    }
+
+    Asm Build_Detour_Sub488CB0()
+    {
+        Asm a;
+        a.IncMem32(kHookCalls + 4 * 0);
+        a.CmpMem8(kHookEnabled + 0, 0);
+        a.Jz("vanilla_path");
+        a.Push(ECX);
+        a.MovR32BaseDisp8(EAX, ECX, 0x08);
+        a.Push(EAX);
+        a.CallMem(kFnIsMedium_Sub488CB0);
+        a.AddReg(ESP, 4);
+        a.TestR8(EAX, EAX);
+        a.Pop(ECX);
+        a.Jnz("medium_path");
+        a.Label("vanilla_path");
+        a.SubReg(ESP, 0x0C);
+        a.FldMem32(kFloatConst_488CB0);
+        a.JmpMem(kResumeAddr_488CB0);
+        a.Label("medium_path");
+        a.PushEspDisp8(0x04);
+        a.Push(ECX);
+        a.CallMem(kFnCalcMediumPieceAR);
+        a.AddReg(ESP, 8);
+        a.Ret(4);
+        return a;
+    }
+
+    Asm Build_ApplyTrapDamageHook()
+    {
+        Asm a;
+        a.IncMem32(kHookCalls + 4 * 4);
+        a.TestR32(EAX, EAX);
+        a.Jnz("node_valid");
+        a.MovRegImm(EAX, kTrap_Safe);
+        a.JmpReg(EAX);
+        a.Label("node_valid");
+        a.FldBaseDisp32(EAX, 0x88);
+        a.MovRegImm(EAX, kTrap_Resume);
+        a.JmpReg(EAX);
+        return a;
+    }
+
+    Asm Build_GetDamageHook()
+    {
+        Asm a;
+        a.IncMem32(kHookCalls + 4 * 5);
+        a.TestR32(EDI, EDI);
+        a.Jz("no_weapon_equipped");
+        a.Label("weapon_valid");
+        a.MovR8BaseDisp8(EAX, EDI, 0x04);
+        a.CmpAl(0x21);
+        a.PushImm(kGetDamage_Resume);
+        a.Ret();
+        a.Label("no_weapon_equipped");
+        a.Pop(EDI);
+        a.Pop(ESI);
+        a.Pop(EBX);
+        a.AddReg(ESP, 0x18);
+        a.Ret();
+        return a;
+    }
+
+    // ── Memory ─────────────────────────────────────────────────────────────
+    class Memory
+    {
+    public:
+        UInt8 Read8(UInt32 addr) const
+        {
+            auto it = m_pages.find(addr >> 12);
+            return it == m_pages.end() ? 0 : it->second[addr & 0xFFF];
+        }
+
+        void Write8(UInt32 addr, UInt8 v) { m_pages[addr >> 12][addr & 0xFFF] = v; }
+
+        UInt32 Read32(UInt32 addr) const
+        {
+            return Read8(addr) | (Read8(addr + 1) << 8) | (Read8(addr + 2) << 16) | (static_cast<UInt32>(Read8(addr + 3)) << 24);
+        }
+
+        void Write32(UInt32 addr, UInt32 v)
+        {
+            for (int i = 0; i < 4; ++i)
+                Write8(addr + i, static_cast<UInt8>(v >> (8 * i)));
+        }
+
+        float ReadFloat(UInt32 addr) const
+        {
+            const UInt32 bits = Read32(addr);
+            float f;
+            std::memcpy(&f, &bits, sizeof(f));
+            return f;
+        }
+
+        void WriteFloat(UInt32 addr, float f)
+        {
+            UInt32 bits;
+            std::memcpy(&bits, &f, sizeof(bits));
+            Write32(addr, bits);
+        }
+
+    private:
+        std::unordered_map<UInt32, std::array<UInt8, 4096>> m_pages;
+    };
+
+    // ── CPU ────────────────────────────────────────────────────────────────
+    struct NativeCall
+    {
+        std::string name;
+        UInt32      args[4];
+    };
+
+    class Machine;
+    typedef std::function<void(Machine&)> NativeFn;
+
+    class Machine
+    {
+    public:
+        UInt32 r[8] = {};
+        UInt32 eip = 0;
+        bool   zf = false, sf = false, cf = false;
+        std::vector<double> fpu;           // back() is ST(0)
+        Memory mem;
+
+        UInt32 steps = 0;
+        UInt32 exitAddr = 0;
+        std::string exitReason;
+        std::vector<NativeCall> calls;
+
+        void LoadCode(const std::vector<UInt8>& code)
+        {
+            for (UInt32 i = 0; i < code.size(); ++i)
+                mem.Write8(kCodeBase + i, code[i]);
+            m_codeEnd = kCodeBase + static_cast<UInt32>(code.size());
+        }
+
+        // Callee-clobbered registers get garbage, like real cdecl code.
+        void AddNative(UInt32 slot, const char* name, NativeFn fn)
+        {
+            const UInt32 addr = kNativeBase + static_cast<UInt32>(m_natives.size()) * 0x10;
+            m_natives[addr] = { name, std::move(fn) };
+            mem.Write32(slot, addr);
+        }
+
+        void AddExit(UInt32 addr, const char* name) { m_exits[addr] = name; }
+
+        void Push(UInt32 v) { r[ESP] -= 4; mem.Write32(r[ESP], v); }
+        UInt32 Pop() { const UInt32 v = mem.Read32(r[ESP]); r[ESP] += 4; return v; }
+        UInt32 Arg(UInt32 i) const { return mem.Read32(r[ESP] + 4 + 4 * i); }
+
+        void Run(UInt32 entry)
+        {
+            eip = entry;
+            for (steps = 0; steps < kMaxSteps; )
+            {
+                if (eip == kReturnSentinel)
+                {
+                    exitReason = "ret";
+                    exitAddr = eip;
+                    return;
+                }
+
+                if (auto e = m_exits.find(eip); e != m_exits.end())
+                {
+                    exitReason = e->second;
+                    exitAddr = eip;
+                    return;
+                }
+
+                if (auto n = m_natives.find(eip); n != m_natives.end())
+                {
+                    NativeCall call = { n->second.name, { Arg(0), Arg(1), Arg(2), Arg(3) } };
+                    calls.push_back(call);
+                    n->second.fn(*this);
+                    r[ECX] = 0xDEADBEEF;
+                    r[EDX] = 0xDEADBEEF;
+                    eip = Pop();
+                    continue;
+                }
+
+                if (eip < kCodeBase || eip >= m_codeEnd)
+                {
+                    exitReason = "wild jump";
+                    exitAddr = eip;
+                    return;
+                }
+
+                ++steps;
+                if (!Step())
+                {
+                    exitReason = "unsupported opcode";
+                    exitAddr = eip;
+                    return;
+                }
+            }
+            exitReason = "step limit";
+        }
+
+    private:
+        struct Native
+        {
+            std::string name;
+            NativeFn    fn;
+        };
+
+        struct Operand
+        {
+            bool   isReg;
+            UInt32 reg;
+            UInt32 addr;
+        };
+
+        UInt8 Fetch8() { return mem.Read8(eip++); }
+        UInt32 Fetch32() { const UInt32 v = mem.Read32(eip); eip += 4; return v; }
+
+        Operand DecodeModRM(UInt8 modrm)
+        {
+            const UInt32 mod = modrm >> 6;
+            const UInt32 rm = modrm & 7;
+            if (mod == 3)
+                return { true, rm, 0 };
+
+            UInt32 addr = 0;
+            if (rm == 4)
+            {
+                const UInt8 sib = Fetch8();
+                const UInt32 base = sib & 7;
+                const UInt32 index = (sib >> 3) & 7;
+                if (index != 4)
+                    addr += r[index] << (sib >> 6);
+                addr += (base == 5 && mod == 0) ? Fetch32() : r[base];
+            }
+            else if (rm == 5 && mod == 0)
+                addr = Fetch32();
+            else
+                addr = r[rm];
+
+            if (mod == 1)
+                addr += static_cast<UInt32>(static_cast<SInt32>(static_cast<SInt8>(Fetch8())));
+            else if (mod == 2)
+                addr += Fetch32();
+            return { false, 0, addr };
+        }
+
+        UInt8 GetR8(UInt32 i) const { return i < 4 ? r[i] & 0xFF : (r[i - 4] >> 8) & 0xFF; }
+        void SetR8(UInt32 i, UInt8 v)
+        {
+            if (i < 4) r[i] = (r[i] & ~0xFFu) | v;
+            else       r[i - 4] = (r[i - 4] & ~0xFF00u) | (static_cast<UInt32>(v) << 8);
+        }
+
+        UInt8 Read8(const Operand& op) const { return op.isReg ? GetR8(op.reg) : mem.Read8(op.addr); }
+        void Write8(const Operand& op, UInt8 v) { if (op.isReg) SetR8(op.reg, v); else mem.Write8(op.addr, v); }
+        UInt32 Read32(const Operand& op) const { return op.isReg ? r[op.reg] : mem.Read32(op.addr); }
+        void Write32(const Operand& op, UInt32 v) { if (op.isReg) r[op.reg] = v; else mem.Write32(op.addr, v); }
+
+        void Flags8(UInt8 v)   { zf = v == 0; sf = (v & 0x80) != 0; }
+        void Flags32(UInt32 v) { zf = v == 0; sf = (v & 0x80000000u) != 0; }
+
+        bool Step()
+        {
+            const UInt8 op = Fetch8();
+
+            if (op >= 0x50 && op <= 0x57) { Push(r[op - 0x50]); return true; }
+            if (op >= 0x58 && op <= 0x5F) { r[op - 0x58] = Pop(); return true; }
+            if (op >= 0xB8 && op <= 0xBF) { r[op - 0xB8] = Fetch32(); return true; }
+
+            switch (op)
+            {
+            case 0x60:  // pushad
+            {
+                const UInt32 esp = r[ESP];
+                for (UInt32 i = 0; i < 8; ++i)
+                    Push(i == ESP ? esp : r[i]);
+                return true;
+            }
+            case 0x61:  // popad
+                for (UInt32 i = 8; i-- > 0; )
+                {
+                    const UInt32 v = Pop();
+                    if (i != ESP)
+                        r[i] = v;
+                }
+                return true;
+            case 0x68: Push(Fetch32()); return true;
+            case 0x74: { const SInt8 d = static_cast<SInt8>(Fetch8()); if (zf) eip += d; return true; }
+            case 0x75: { const SInt8 d = static_cast<SInt8>(Fetch8()); if (!zf) eip += d; return true; }
+            case 0xEB: { const SInt8 d = static_cast<SInt8>(Fetch8()); eip += d; return true; }
+            case 0xE8: { const UInt32 d = Fetch32(); Push(eip); eip += d; return true; }
+            case 0xE9: { const UInt32 d = Fetch32(); eip += d; return true; }
+            case 0xC3: eip = Pop(); return true;
+            case 0xC2:
+            {
+                const UInt16 n = static_cast<UInt16>(Fetch8() | (Fetch8() << 8));
+                eip = Pop();
+                r[ESP] += n;
+                return true;
+            }
+            case 0x24: { const UInt8 v = GetR8(EAX) & Fetch8(); SetR8(EAX, v); Flags8(v); cf = false; return true; }
+            case 0x3C: { const UInt8 a = GetR8(EAX), imm = Fetch8(); Flags8(static_cast<UInt8>(a - imm)); cf = a < imm; return true; }
+            case 0xA1: r[EAX] = mem.Read32(Fetch32()); return true;
+            default:
+                break;
+            }
+
+            const UInt8 modrm = Fetch8();
+            const UInt32 reg = (modrm >> 3) & 7;
+            const Operand rm = DecodeModRM(modrm);
+
+            switch (op)
+            {
+            case 0x1B:  // sbb r32, r/m32
+            {
+                const UInt64 sub = static_cast<UInt64>(Read32(rm)) + (cf ? 1 : 0);
+                const UInt32 v = r[reg] - static_cast<UInt32>(sub);
+                cf = r[reg] < sub;
+                r[reg] = v;
+                Flags32(v);
+                return true;
+            }
+            case 0x32: { const UInt8 v = GetR8(reg) ^ Read8(rm); SetR8(reg, v); Flags8(v); cf = false; return true; }
+            case 0x84: { Flags8(Read8(rm) & GetR8(reg)); cf = false; return true; }
+            case 0x85: { Flags32(Read32(rm) & r[reg]); cf = false; return true; }
+            case 0x89: Write32(rm, r[reg]); return true;
+            case 0x8A: SetR8(reg, Read8(rm)); return true;
+            case 0x8B: r[reg] = Read32(rm); return true;
+            case 0x80:  // group 1, r/m8, imm8
+            {
+                const UInt8 imm = Fetch8();
+                const UInt8 a = Read8(rm);
+                if (reg != 7)
+                    return false;
+                Flags8(static_cast<UInt8>(a - imm));
+                cf = a < imm;
+                return true;
+            }
+            case 0x83:  // group 1, r/m32, imm8 sign-extended
+            {
+                const UInt32 imm = static_cast<UInt32>(static_cast<SInt32>(static_cast<SInt8>(Fetch8())));
+                const UInt32 a = Read32(rm);
+                UInt32 v;
+                switch (reg)
+                {
+                case 0: v = a + imm; cf = v < a; break;
+                case 4: v = a & imm; cf = false; break;
+                case 5: v = a - imm; cf = a < imm; break;
+                case 7: v = a - imm; cf = a < imm; Flags32(v); return true;
+                default: return false;
+                }
+                Write32(rm, v);
+                Flags32(v);
+                return true;
+            }
+            case 0xC0:  // group 2, r/m8, imm8
+            {
+                const UInt8 n = Fetch8() & 0x1F;
+                if (reg != 5)
+                    return false;
+                const UInt8 a = Read8(rm);
+                if (n)
+                {
+                    cf = ((a >> (n - 1)) & 1) != 0;
+                    const UInt8 v = static_cast<UInt8>(a >> n);
+                    Write8(rm, v);
+                    Flags8(v);
+                }
+                return true;
+            }
+            case 0xC6:
+                if (reg != 0)
+                    return false;
+                Write8(rm, Fetch8());
+                return true;
+            case 0xF6:  // group 3, r/m8
+            {
+                if (reg != 3)
+                    return false;
+                const UInt8 a = Read8(rm);
+                const UInt8 v = static_cast<UInt8>(-a);
+                cf = a != 0;
+                Write8(rm, v);
+                Flags8(v);
+                return true;
+            }
+            case 0xD9:
+                if (rm.isReg)
+                    return false;
+                if (reg == 0) { fpu.push_back(mem.ReadFloat(rm.addr)); return true; }
+                if (reg == 3)
+                {
+                    if (fpu.empty())
+                        return false;
+                    mem.WriteFloat(rm.addr, static_cast<float>(fpu.back()));
+                    fpu.pop_back();
+                    return true;
+                }
+                return false;
+            case 0xFF:  // group 5
+            {
+                const UInt32 v = Read32(rm);
+                switch (reg)
+                {
+                case 0: { const UInt32 n = v + 1; Write32(rm, n); Flags32(n); return true; }
+                case 2: Push(eip); eip = v; return true;
+                case 4: eip = v; return true;
+                case 6: Push(v); return true;
+                default: return false;
+                }
+            }
+            default:
+                return false;
+            }
+        }
+
+        std::map<UInt32, Native>      m_natives;
+        std::map<UInt32, std::string> m_exits;
+        UInt32                        m_codeEnd = kCodeBase;
+    };
+
+    // ── Scenarios ──────────────────────────────────────────────────────────
+    struct World
+    {
+        bool  isMedium = false;
+        float pieceAR = 37.0f;
+        double cachedAR = 55.0;
+    };
+
+    class Checker
+    {
+    public:
+        void Expect(bool ok, const char* fmt, ...)
+        {
+            if (ok)
+                return;
+            char text[256];
+            va_list args;
+            va_start(args, fmt);
+            std::vsnprintf(text, sizeof(text), fmt, args);
+            va_end(args);
+            failures.push_back(text);
+        }
+
+        void Note(const char* text) { notes.push_back(text); }
+
+        std::vector<std::string> failures;
+        std::vector<std::string> notes;
+    };
+
+    struct Scenario
+    {
+        const char* stub;
+        const char* path;
+        Asm (*build)();
+        std::function<void(Machine&, World&)> setup;
+        std::function<void(const Machine&, const UInt32* entryRegs, Checker&)> check;
+    };
+
+    constexpr UInt32 kArmorForm = kObjectBase + 0x000;
+    constexpr UInt32 kEquippedInstance = kObjectBase + 0x100;
+    constexpr UInt32 kActor = kObjectBase + 0x200;
+    constexpr UInt32 kNiNode = kObjectBase + 0x300;
+    constexpr UInt32 kWeapon = kObjectBase + 0x400;
+
+    void InitMachine(Machine& m, World& w)
+    {
+        for (UInt32 i = 0; i < 6; ++i)
+            m.mem.Write8(kHookEnabled + i, 1);
+
+        m.r[EAX] = 0x11111111;
+        m.r[ECX] = kArmorForm;
+        m.r[EDX] = 0x22222222;
+        m.r[EBX] = 0x33333333;
+        m.r[EBP] = 0x44444444;
+        m.r[ESI] = 0x55555555;
+        m.r[EDI] = 0x66666666;
+        m.r[ESP] = kStackTop;
+
+        World* world = &w;
+        auto isMedium = [world](Machine& mm) { mm.r[EAX] = (mm.r[EAX] & ~0xFFu) | (world->isMedium ? 1 : 0); };
+        m.AddNative(kFnIsMedium_Sub488CB0, "IsMediumArmor_Sub488CB0", isMedium);
+        m.AddNative(kFnIsMedium_IsHeavyArmor, "IsMediumArmor_IsHeavyArmor", isMedium);
+        m.AddNative(kFnIsMedium_GetArmorSkillAV, "IsMediumArmor_GetArmorSkillAV", isMedium);
+        m.AddNative(kFnCalcMediumPieceAR, "CalcMediumPieceAR", [world](Machine& mm) { mm.r[EAX] = 0x77777777; mm.fpu.push_back(world->pieceAR); });
+        m.AddNative(kFnCachedCalcAR, "CachedCalcArmorRating", [world](Machine& mm) { mm.r[EAX] = 0x77777777; mm.fpu.push_back(world->cachedAR); });
+
+        m.mem.Write32(kResumeAddr_488CB0, kResume_488CB0);
+        m.mem.Write32(kResumeAddr_CalcAR, kTrampoline_CalcAR);
+        m.AddExit(kResume_488CB0, "resume sub_488CB0+9");
+        m.AddExit(kTrampoline_CalcAR, "Calc_ArmorRating trampoline");
+        m.AddExit(kTrap_Safe, "ApplyTrapDamage safe exit");
+        m.AddExit(kTrap_Resume, "ApplyTrapDamage resume");
+        m.AddExit(kGetDamage_Resume, "GetDamage resume");
+
+        m.mem.WriteFloat(kFloatConst_488CB0, 0.01f);
+        m.mem.Write32(kEquippedInstance + 0x8, kArmorForm);
+        m.mem.WriteFloat(kNiNode + 0x88, 2.5f);
+        m.mem.Write8(kWeapon + 0x4, 0x21);
+    }
+
+    // Registers a stub must hand back untouched on this path.
+    void ExpectPreserved(const Machine& m, const UInt32* entry, Checker& c, std::initializer_list<Reg> regs)
+    {
+        for (Reg reg : regs)
+            c.Expect(m.r[reg] == entry[reg], "%s changed: %08X -> %08X", kRegNames[reg], entry[reg], m.r[reg]);
+    }
+
+    const NativeCall* FindCall(const Machine& m, const char* name)
+    {
+        for (const NativeCall& call : m.calls)
+        {
+            if (call.name == name)
+                return &call;
+        }
+        return nullptr;
+    }
+
+    float AsFloat(UInt32 bits)
+    {
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+
+    UInt32 FloatBits(float f)
+    {
+        UInt32 bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        return bits;
+    }
+
+    // thiscall on ECX, no stack args: just a return address.
+    void PushThiscallFrame(Machine& m) { m.Push(kReturnSentinel); }
+
+    // Calc_ArmorRating(baseAR, skill, luck, condition), cdecl.
+    void PushCalcARFrame(Machine& m)
+    {
+        m.Push(FloatBits(0.75f));   // condition
+        m.Push(FloatBits(50.0f));   // luck
+        m.Push(FloatBits(10.0f));   // skill
+        m.Push(12);                 // baseAR
+        m.Push(kReturnSentinel);
+    }
+
+    std::vector<Scenario> MakeScenarios()
+    {
+        std::vector<Scenario> s;
+
+        // ── Hook 2 ──────────────────────────────────────────────────────────
+        s.push_back({ "Detour_IsHeavyArmor", "medium", &Build_Detour_IsHeavyArmor,
+            [](Machine& m, World& w) { w.isMedium = true; m.mem.Write8(kArmorForm + 0x6A, 0x80); PushThiscallFrame(m); },
+            [](const Machine& m, const UInt32* e, Checker& c)
+            {
+                c.Expect(m.exitReason == "ret", "exit %s", m.exitReason.c_str());
+                c.Expect((m.r[EAX] & 0xFF) == 0, "al = %u, want 0", m.r[EAX] & 0xFF);
+                c.Expect(m.r[ESP] == e[ESP] + 4, "esp delta %d", static_cast<int>(m.r[ESP] - e[ESP]));
+                ExpectPreserved(m, e, c, { ECX, EBX, EBP, ESI, EDI });
+            } });
+
+        s.push_back({ "Detour_IsHeavyArmor", "heavy", &Build_Detour_IsHeavyArmor,
+            [](Machine& m, World&) { m.mem.Write8(kArmorForm + 0x6A, 0x80); PushThiscallFrame(m); },
+            [](const Machine& m, const UInt32* e, Checker& c)
+            {
+                c.Expect(m.exitReason == "ret", "exit %s", m.exitReason.c_str());
+                c.Expect((m.r[EAX] & 0xFF) == 1, "al = %u, want 1", m.r[EAX] & 0xFF);
+                ExpectPreserved(m, e, c, { ECX, EBX, EBP, ESI, EDI });
+            } });
+
+        s.push_back({ "Detour_IsHeavyArmor", "disabled", &Build_Detour_IsHeavyArmor,
+            [](Machine& m, World& w) { w.isMedium = true; m.mem.Write8(kHookEnabled + 1, 0); m.mem.Write8(kArmorForm + 0x6A, 0x80); PushThiscallFrame(m); },
+            [](const Machine& m, const UInt32* e, Checker& c)
+            {
+                c.Expect((m.r[EAX] & 0xFF) == 1, "al = %u, want vanilla 1", m.r[EAX] & 0xFF);
+                c.Expect(m.calls.empty(), "callout ran while disabled");
+                c.Expect(m.mem.Read32(kHookCalls + 4) == 1, "call counter not bumped");
+                ExpectPreserved(m, e, c, { ECX, EDX, EBX, EBP, ESI, EDI });
+            } });
+
+        // ── Hook 3 ──────────────────────────────────────────────────────────
+        s.push_back({ "Detour_GetArmorSkillAV", "medium", &Build_Detour_GetArmorSkillAV,
+            [](Machine& m, World& w) { w.isMedium = true; PushThiscallFrame(m); },
+            [](const Machine& m, const UInt32* e, Checker& c)
+            {
+                c.Expect(m.r[EAX] == 0x1B, "eax = %X, want 1B (light armor AV)", m.r[EAX]);
+                c.Expect(m.mem.Read8(kMediumArmorFlag) == 1, "flag not set");
+                c.Expect(m.mem.Read32(kMediumArmorForm) == kArmorForm, "form %08X not remembered", m.mem.Read32(kMediumArmorForm));
+                c.Expect(m.calls.size() == 1, "%zu callouts, want only the classification", m.calls.size());
+                c.Expect(m.fpu.empty(), "FPU stack not balanced (%zu)", m.fpu.size());
+                ExpectPreserved(m, e, c, { ECX, EBX, EBP, ESI, EDI });
+            } });
+
+        s.push_back({ "Detour_GetArmorSkillAV", "heavy", &Build_Detour_GetArmorSkillAV,
+            [](Machine& m, World&) { m.mem.Write8(kArmorForm + 0x6A, 0x80); PushThiscallFrame(m); },
+            [](const Machine& m, const UInt32* e, Checker& c)
+            {
+                c.Expect(m.r[EAX] == 0x12, "eax = %X, want 12 (heavy armor AV)", m.r[EAX]);
+                c.Expect(m.mem.Read8(kMediumArmorFlag) == 0, "flag set for heavy");
+                ExpectPreserved(m, e, c, { ECX, EBX, EBP, ESI, EDI });
+            } });
+
+        s.push_back({ "Detour_GetArmorSkillAV", "light", &Build_Detour_GetArmorSkillAV,
+            [](Machine& m, World&) { PushThiscallFrame(m); },
+            [](const Machine& m, const UInt32* e, Checker& c)
+            {
+                c.Expect(m.r[EAX] == 0x1B, "eax = %X, want 1B", m.r[EAX]);
+                ExpectPreserved(m, e, c, { ECX, EBX, EBP, ESI, EDI });
+            } });
+
+        // ── Hook 4 ──────────────────────────────────────────────────────────
+        s.push_back({ "Detour_CalcArmorRating", "flag set", &Build_Detour_CalcArmorRating,
+            [](Machine& m, World&) { m.mem.Write8(kMediumArmorFlag, 1); m.mem.Write32(kMediumArmorForm, kArmorForm); PushCalcARFrame(m); },
+            [](const Machine& m, const UInt32* e, Checker& c)
+            {
+                const NativeCall* call = FindCall(m, "CachedCalcArmorRating");
+                c.Expect(call != nullptr, "CachedCalcArmorRating not reached");
+                if (call)
+                {
+                    c.Expect(call->args[0] == 12, "baseAR arg %u", call->args[0]);
+                    c.Expect(AsFloat(call->args[1]) == 10.0f, "skill arg %.2f, want the caller's 10.0", AsFloat(call->args[1]));
+                    c.Expect(AsFloat(call->args[2]) == 50.0f, "luck arg %.2f", AsFloat(call->args[2]));
+                    c.Expect(AsFloat(call->args[3]) == 0.75f, "condition arg %.2f", AsFloat(call->args[3]));
+                }
+                c.Expect(m.exitReason == "ret", "exit %s", m.exitReason.c_str());
+                c.Expect(m.mem.Read8(kMediumArmorFlag) == 0, "flag not cleared");
+                c.Expect(m.fpu.size() == 1 && m.fpu.back() == 55.0, "result not in ST(0)");
+                c.Expect(m.r[ESP] == e[ESP] + 4, "esp delta %d", static_cast<int>(m.r[ESP] - e[ESP]));
+            } });
+
+        s.push_back({ "Detour_CalcArmorRating", "flag clear", &Build_Detour_CalcArmorRating,
+            [](Machine& m, World&) { PushCalcARFrame(m); },
+            [](const Machine& m, const UInt32* e, Checker& c)
+            {
+                c.Expect(m.exitAddr == kTrampoline_CalcAR, "exit %s", m.exitReason.c_str());
+                c.Expect(AsFloat(m.mem.Read32(m.r[ESP] + 8)) == 10.0f, "skill arg modified");
+                c.Expect(m.r[ESP] == e[ESP], "esp moved");
+                ExpectPreserved(m, e, c, { EAX, ECX, EDX, EBX, EBP, ESI, EDI });
+            } });
+
+        s.push_back({ "Detour_CalcArmorRating", "disabled, flag set", &Build_Detour_CalcArmorRating,
+            [](Machine& m, World&) { m.mem.Write8(kHookEnabled + 3, 0); m.mem.Write8(kMediumArmorFlag, 1); PushCalcARFrame(m); },
+            [](const Machine& m, const UInt32* e, Checker& c)
+            {
+                c.Expect(m.exitAddr == kTrampoline_CalcAR, "exit %s", m.exitReason.c_str());
+                c.Expect(m.mem.Read8(kMediumArmorFlag) == 0, "stale flag left set");
+                c.Expect(AsFloat(m.mem.Read32(m.r[ESP] + 8)) == 10.0f, "skill arg modified");
+                ExpectPreserved(m, e, c, { EAX, ECX, EDX, EBX, EBP, ESI, EDI });
+            } });
+
+        // ── Hook 1 ──────────────────────────────────────────────────────────
+        s.push_back({ "Detour_Sub488CB0", "medium", &Build_Detour_Sub488CB0,
+            [](Machine& m, World& w) { w.isMedium = true; m.r[ECX] = kEquippedInstance; m.Push(kActor); m.Push(kReturnSentinel); },
+            [](const Machine& m, const UInt32* e, Checker& c)
+            {
+                const NativeCall* call = FindCall(m, "CalcMediumPieceAR");
+                c.Expect(call != nullptr, "CalcMediumPieceAR not reached");
+                if (call)
+                {
+                    c.Expect(call->args[0] == kEquippedInstance, "instance arg %08X", call->args[0]);
+                    c.Expect(call->args[1] == kActor, "actor arg %08X", call->args[1]);
+                }
+                const NativeCall* classify = FindCall(m, "IsMediumArmor_Sub488CB0");
+                c.Expect(classify && classify->args[0] == kArmorForm, "classified the wrong form");
+                c.Expect(m.exitReason == "ret", "exit %s", m.exitReason.c_str());
+                c.Expect(m.r[ESP] == e[ESP] + 8, "esp delta %d, want 8 (ret 4)", static_cast<int>(m.r[ESP] - e[ESP]));
+                c.Expect(m.fpu.size() == 1 && m.fpu.back() == 37.0, "AR not in ST(0)");
+                ExpectPreserved(m, e, c, { EBX, EBP, ESI, EDI });
+            } });
+
+        s.push_back({ "Detour_Sub488CB0", "not medium", &Build_Detour_Sub488CB0,
+            [](Machine& m, World&) { m.r[ECX] = kEquippedInstance; m.Push(kActor); m.Push(kReturnSentinel); },
+            [](const Machine& m, const UInt32* e, Checker& c)
+            {
+                c.Expect(m.exitAddr == kResume_488CB0, "exit %s", m.exitReason.c_str());
+                c.Expect(m.r[ESP] == e[ESP] - 0x0C, "esp delta %d, want -12", static_cast<int>(m.r[ESP] - e[ESP]));
+                c.Expect(m.fpu.size() == 1 && static_cast<float>(m.fpu.back()) == 0.01f, "stolen fld not replayed");
+                ExpectPreserved(m, e, c, { ECX, EBX, EBP, ESI, EDI });
+            } });
+
+        // ── Patches ─────────────────────────────────────────────────────────
+        s.push_back({ "ApplyTrapDamageHook", "null node", &Build_ApplyTrapDamageHook,
+            [](Machine& m, World&) { m.r[EAX] = 0; m.Push(kReturnSentinel); },
+            [](const Machine& m, const UInt32*, Checker& c)
+            {
+                c.Expect(m.exitAddr == kTrap_Safe, "exit %s", m.exitReason.c_str());
+                c.Expect(m.fpu.empty(), "FPU touched on the null path");
+            } });
+
+        s.push_back({ "ApplyTrapDamageHook", "enable byte clear", &Build_ApplyTrapDamageHook,
+            [](Machine& m, World&) { m.mem.Write8(kHookEnabled + 4, 0); m.r[EAX] = 0; m.Push(kReturnSentinel); },
+            [](const Machine& m, const UInt32*, Checker& c)
+            {
+                c.Expect(m.exitAddr == kTrap_Safe, "exit %s: the crash fix must not be switchable", m.exitReason.c_str());
+                c.Expect(m.fpu.empty(), "FPU touched on the null path");
+            } });
+
+        s.push_back({ "ApplyTrapDamageHook", "valid node", &Build_ApplyTrapDamageHook,
+            [](Machine& m, World&) { m.r[EAX] = kNiNode; m.Push(kReturnSentinel); },
+            [](const Machine& m, const UInt32* e, Checker& c)
+            {
+                c.Expect(m.exitAddr == kTrap_Resume, "exit %s", m.exitReason.c_str());
+                c.Expect(m.fpu.size() == 1 && m.fpu.back() == 2.5, "fld [eax+88h] not replayed");
+                ExpectPreserved(m, e, c, { ECX, EDX, EBX, EBP, ESI, EDI });
+                if (m.r[EAX] != e[EAX])
+                    c.Note("eax holds the resume address on exit; the engine's use of eax after 0x005ED1FE decides whether that matters");
+            } });
+
+        s.push_back({ "GetDamageHook", "null weapon", &Build_GetDamageHook,
+            [](Machine& m, World&)
+            {
+                // Frame of EquippedWeaponData::GetDamage at 0x484F99: 0x18 locals,
+                // then ebx/esi/edi pushed.
+                m.Push(kReturnSentinel);
+                m.r[ESP] -= 0x18;
+                m.Push(0xB0B0B0B0);     // saved ebx
+                m.Push(0x50505050);     // saved esi
+                m.Push(0xD0D0D0D0);     // saved edi
+                m.r[EDI] = 0;
+            },
+            [](const Machine& m, const UInt32* e, Checker& c)
+            {
+                c.Expect(m.exitReason == "ret", "exit %s", m.exitReason.c_str());
+                c.Expect(m.r[ESP] == e[ESP] + 0x28, "esp delta %d, want 40", static_cast<int>(m.r[ESP] - e[ESP]));
+                c.Expect(m.r[EBX] == 0xB0B0B0B0 && m.r[ESI] == 0x50505050 && m.r[EDI] == 0xD0D0D0D0,
+                    "callee-saved registers not restored");
+                c.Expect(m.calls.empty(), "callout from the mid-function stub");
+            } });
+
+        s.push_back({ "GetDamageHook", "valid weapon", &Build_GetDamageHook,
+            [](Machine& m, World&) { m.r[EDI] = kWeapon; m.Push(kReturnSentinel); },
+            [](const Machine& m, const UInt32* e, Checker& c)
+            {
+                c.Expect(m.exitAddr == kGetDamage_Resume, "exit %s", m.exitReason.c_str());
+                c.Expect((m.r[EAX] & 0xFF) == 0x21, "al = %X, want form type 21", m.r[EAX] & 0xFF);
+                c.Expect(m.zf && !m.cf, "flags of cmp al,21h not carried to the resume");
+                c.Expect((m.r[EAX] & ~0xFFu) == (e[EAX] & ~0xFFu), "upper eax bytes clobbered");
+                c.Expect(m.calls.empty(), "callout from the mid-function stub");
+                c.Expect(m.r[ESP] == e[ESP], "esp moved");
+                ExpectPreserved(m, e, c, { ECX, EDX, EBX, EBP, ESI, EDI });
+            } });
+
+        s.push_back({ "GetDamageHook", "enable byte clear", &Build_GetDamageHook,
+            [](Machine& m, World&)
+            {
+                m.mem.Write8(kHookEnabled + 5, 0);
+                m.Push(kReturnSentinel);
+                m.r[ESP] -= 0x18;
+                m.Push(0xB0B0B0B0);
+                m.Push(0x50505050);
+                m.Push(0xD0D0D0D0);
+                m.r[EDI] = 0;
+            },
+            [](const Machine& m, const UInt32* e, Checker& c)
+            {
+                c.Expect(m.exitReason == "ret", "exit %s: the crash fix must not be switchable", m.exitReason.c_str());
+                c.Expect(m.r[ESP] == e[ESP] + 0x28, "esp delta %d, want 40", static_cast<int>(m.r[ESP] - e[ESP]));
+            } });
+
+        return s;
+    }
+
+    // ── Patch footprints ───────────────────────────────────────────────────
+    // Mid-function sites the stubs return into.  `original` is the stub's
+    // kExpected: every instruction under the 5-byte jmp, which the stub must
+    // replay before resuming at the next instruction boundary.
+    struct Footprint
+    {
+        const char*        stub;
+        Asm              (*build)();
+        UInt32             site;
+        UInt32             stolenLen;
+        UInt32             resume;
+        std::vector<UInt8> original;
+    };
+
+    std::vector<Footprint> MakeFootprints()
+    {
+        return {
+            { "Detour_Sub488CB0", &Build_Detour_Sub488CB0, kSite_488CB0, 9, kResume_488CB0,
+                { 0x83, 0xEC, 0x0C, 0xD9, 0x05, 0x34, 0x06, 0xA3, 0x00 } },
+            { "ApplyTrapDamageHook", &Build_ApplyTrapDamageHook, kTrap_Site, 6, kTrap_Resume,
+                { 0xD9, 0x80, 0x88, 0x00, 0x00, 0x00 } },
+            { "GetDamageHook", &Build_GetDamageHook, kGetDamage_Site, 5, kGetDamage_Resume,
+                { 0x8A, 0x47, 0x04, 0x3C, 0x21 } },
+        };
+    }
+
+    bool CheckFootprint(const Footprint& f, Checker& c)
+    {
+        Asm code = f.build();
+        c.Expect(code.Link(), "assembler: unresolved or out-of-range label");
+        c.Expect(f.stolenLen >= 5, "stolen %u bytes, the jmp needs 5", f.stolenLen);
+        c.Expect(f.original.size() == f.stolenLen, "kExpected covers %zu of %u overwritten bytes",
+            f.original.size(), f.stolenLen);
+        c.Expect(f.resume == f.site + f.stolenLen, "resumes at %08X, inside or past the %u bytes at %08X",
+            f.resume, f.stolenLen, f.site);
+
+        const auto at = std::search(code.bytes.begin(), code.bytes.end(), f.original.begin(), f.original.end());
+        c.Expect(at != code.bytes.end(), "stub does not replay the overwritten instructions");
+        return c.failures.empty();
+    }
+
+    void DumpStub(const char* name, const std::vector<UInt8>& bytes)
+    {
+        std::printf("%s (%zu bytes)\n", name, bytes.size());
+        for (size_t i = 0; i < bytes.size(); ++i)
+            std::printf("%02X%s", bytes[i], (i % 16 == 15 || i + 1 == bytes.size()) ? "\n" : " ");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool dump = false;
+    bool verbose = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "--dump"))         dump = true;
+        else if (!std::strcmp(argv[i], "--verbose")) verbose = true;
+        else
+        {
+            std::fprintf(stderr, "usage: stubemu [--dump] [--verbose]\n");
+            return 2;
+        }
+    }
+
+    UInt32 failed = 0;
+    const char* lastDumped = nullptr;
+    const std::vector<Scenario> scenarios = MakeScenarios();
+
+    for (const Scenario& sc : scenarios)
+    {
+        Asm code = sc.build();
+        if (!code.Link())
+        {
+            std::printf("FAIL  %-24s %-20s  assembler: unresolved or out-of-range label\n", sc.stub, sc.path);
+            ++failed;
+            continue;
+        }
+
+        if (dump && sc.stub != lastDumped)
+        {
+            DumpStub(sc.stub, code.bytes);
+            lastDumped = sc.stub;
+        }
+
+        Machine m;
+        World world;
+        InitMachine(m, world);
+        m.LoadCode(code.bytes);
+        sc.setup(m, world);
+
+        UInt32 entry[8];
+        std::memcpy(entry, m.r, sizeof(entry));
+
+        m.Run(kCodeBase);
+
+        Checker c;
+        if (m.exitReason == "unsupported opcode" || m.exitReason == "wild jump" || m.exitReason == "step limit")
+            c.Expect(false, "%s at %08X", m.exitReason.c_str(), m.exitAddr);
+        else
+            sc.check(m, entry, c);
+
+        std::printf("%s  %-24s %-20s %3u insns  %zu calls  exit: %s\n",
+            c.failures.empty() ? "PASS" : "FAIL", sc.stub, sc.path, m.steps, m.calls.size(), m.exitReason.c_str());
+
+        for (const std::string& f : c.failures)
+            std::printf("        - %s\n", f.c_str());
+        for (const std::string& n : c.notes)
+            std::printf("        note: %s\n", n.c_str());
+
+        if (verbose)
+        {
+            std::printf("        ");
+            for (UInt32 i = 0; i < 8; ++i)
+                std::printf("%s=%08X ", kRegNames[i], m.r[i]);
+            std::printf("esp%+d", static_cast<int>(m.r[ESP] - entry[ESP]));
+            if (!m.fpu.empty())
+                std::printf(" st0=%g", m.fpu.back());
+            std::printf("\n");
+        }
+
+        failed += c.failures.empty() ? 0 : 1;
+    }
+
+    const std::vector<Footprint> footprints = MakeFootprints();
+    for (const Footprint& f : footprints)
+    {
+        Checker c;
+        const bool ok = CheckFootprint(f, c);
+        std::printf("%s  %-24s %-20s %08X..%08X -> %08X\n", ok ? "PASS" : "FAIL", f.stub, "footprint",
+            f.site, f.site + f.stolenLen - 1, f.resume);
+        for (const std::string& text : c.failures)
+            std::printf("        - %s\n", text.c_str());
+        failed += ok ? 0 : 1;
+    }
+
+    std::printf("%zu scenarios, %zu footprints, %u failed\n", scenarios.size(), footprints.size(), failed);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,25 @@
+#pragma once
+// ============================================================================
+//  MediumArmor OBSE Plugin - tools/ToolPrefix.h
+//
+//  Stand-in for obse_common/obse_prefix.h when building the Linux tools
+//  against the plugin's portable sources.  Force-include it:
+//
+//      g++ -include tools/ToolPrefix.h -I. ...
+// ============================================================================
+
+#include <cstdint>
+#include <cstdio>
+
+typedef uint8_t  UInt8;
+typedef uint16_t UInt16;
+typedef uint32_t UInt32;
+typedef uint64_t UInt64;
+typedef int8_t   SInt8;
+typedef int16_t  SInt16;
+typedef int32_t  SInt32;
+typedef int64_t  SInt64;
+
+#define _MESSAGE(...) (std::fprintf(stderr, __VA_ARGS__), std::fputc('\n', stderr))
+#define _WARNING(...) _MESSAGE(__VA_ARGS__)
+#define _ERROR(...)   _MESSAGE(__VA_ARGS__)
@@ -0,0 +1,271 @@
+// ============================================================================
+//  MediumArmor OBSE Plugin - tools/TraceCheck.cpp
+//
+//  Captures spans through Trace, exports them and reads the JSON back:
+//
+//      - nested scopes export as balanced B/E pairs per thread, in order,
+//        with timestamps that never go backwards
+//      - names are escaped
+//      - each recording thread gets its own tid
+//      - a scope open across Stop()/Start() puts no 'E' in the new capture
+//      - a full buffer drops new spans but still closes recorded ones
+//      - Start() while capturing, Export() while capturing and a buffer
+//        too small for the 'E' reserve are refused
+//
+//  Build (Linux):
+//      g++ -O2 -std=c++20 -pthread -include tools/ToolPrefix.h -I.
+//          tools/TraceCheck.cpp Trace.cpp -o tracecheck
+//
+//  Exit code is non-zero if any check fails.
+// ============================================================================
+
+#include "Trace.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace
+{
+    namespace Trace = MediumArmor::Trace;
+
+    int s_failed = 0;
+
+    void Check(bool ok, const char* what)
+    {
+        std::printf("%s  %s\n", ok ? "ok  " : "FAIL", what);
+        if (!ok)
+            ++s_failed;
+    }
+
+    struct Exported
+    {
+        std::string name;     // still escaped
+        char        phase;
+        double      ts;
+        uint32_t    tid;
+    };
+
+    struct ExportFile
+    {
+        bool                  ok = false;     // written and well-formed
+        std::string           text;
+        std::vector<Exported> events;
+    };
+
+    // Export() writes one event per line between a fixed head and tail.
+    ExportFile ExportAndRead()
+    {
+        ExportFile out;
+        char path[] = "/tmp/tracecheck.XXXXXX";
+        const int fd = mkstemp(path);
+        if (fd < 0)
+            return out;
+        close(fd);
+
+        const bool written = Trace::Export(path);
+        std::FILE* f = std::fopen(path, "r");
+        if (f)
+        {
+            char chunk[4096];
+            size_t n;
+            while ((n = std::fread(chunk, 1, sizeof(chunk), f)) > 0)
+                out.text.append(chunk, n);
+            std::fclose(f);
+        }
+        std::remove(path);
+        if (!written)
+            return out;
+
+        const char* head = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        const char* tail = "\n]}\n";
+        if (out.text.compare(0, std::strlen(head), head) != 0
+            || out.text.size() < std::strlen(tail)
+            || out.text.compare(out.text.size() - std::strlen(tail), std::string::npos, tail) != 0)
+            return out;
+
+        size_t pos = std::strlen(head);
+        const size_t end = out.text.size() - std::strlen(tail);
+        while (pos < end)
+        {
+            const size_t lineEnd = std::min(out.text.find('\n', pos + 1), end);
+            std::string line = out.text.substr(pos, lineEnd - pos);
+            pos = lineEnd;
+            if (line == "\n" || line.empty())
+                continue;
+
+            const size_t nameAt = line.find("{\"name\":\"");
+            const size_t nameEnd = line.find("\",\"cat\":\"MediumArmor\",\"ph\":\"");
+            if (nameAt == std::string::npos || nameEnd == std::string::npos)
+                return out;
+
+            Exported ev;
+            ev.name = line.substr(nameAt + 9, nameEnd - nameAt - 9);
+            if (std::sscanf(line.c_str() + nameEnd, "\",\"cat\":\"MediumArmor\",\"ph\":\"%c\",\"ts\":%lf,\"pid\":1,\"tid\":%u}",
+                &ev.phase, &ev.ts, &ev.tid) != 3)
+                return out;
+            out.events.push_back(ev);
+        }
+
+        out.ok = true;
+        return out;
+    }
+
+    // Every tid's events form properly nested B/E pairs with matching
+    // names, and timestamps never go backwards.
+    bool Balanced(const ExportFile& file)
+    {
+        std::vector<std::vector<std::string>> open(Trace::kMaxThreads);
+        std::vector<double> last(Trace::kMaxThreads, 0.0);
+        for (const Exported& ev : file.events)
+        {
+            if (ev.tid >= Trace::kMaxThreads || ev.ts < last[ev.tid])
+                return false;
+            last[ev.tid] = ev.ts;
+
+            std::vector<std::string>& stack = open[ev.tid];
+            if (ev.phase == 'B')
+                stack.push_back(ev.name);
+            else if (ev.phase != 'E' || stack.empty() || stack.back() != ev.name)
+                return false;
+            else
+                stack.pop_back();
+        }
+        for (const auto& stack : open)
+        {
+            if (!stack.empty())
+                return false;
+        }
+        return true;
+    }
+
+    uint32_t CountNamed(const ExportFile& file, const char* name, char phase)
+    {
+        uint32_t n = 0;
+        for (const Exported& ev : file.events)
+            n += ev.name == name && ev.phase == phase ? 1 : 0;
+        return n;
+    }
+
+    void CheckNesting()
+    {
+        Check(Trace::Start(1024), "start");
+        Check(!Trace::Start(1024), "a second start while capturing is refused");
+        {
+            MA_TRACE_SCOPE("Outer");
+            for (int i = 0; i < 3; ++i)
+            {
+                MA_TRACE_SCOPE("Inner");
+                MA_TRACE_SCOPE("Innermost");
+            }
+        }
+        Check(!Trace::Export("/tmp/tracecheck.unused"), "export while capturing is refused");
+        Trace::Stop();
+
+        const ExportFile file = ExportAndRead();
+        Check(file.ok && file.events.size() == 14 && Trace::GetRecordedCount() == 14 && Trace::GetDroppedCount() == 0,
+            "every span exports, one event per line");
+        Check(Balanced(file), "B/E pairs nest and timestamps never go backwards");
+        Check(file.ok && file.events.front().name == "Outer" && file.events.back().name == "Outer"
+            && CountNamed(file, "Inner", 'B') == 3 && CountNamed(file, "Innermost", 'E') == 3,
+            "events keep their names and order");
+
+        { MA_TRACE_SCOPE("AfterStop"); }
+        Check(Trace::GetRecordedCount() == 14, "nothing is recorded after Stop()");
+    }
+
+    void CheckEscaping()
+    {
+        Trace::Start(1024);
+        { MA_TRACE_SCOPE("quote\" back\\ tab\t"); }
+        Trace::Stop();
+
+        const ExportFile file = ExportAndRead();
+        Check(file.ok && file.events.size() == 2 && file.events[0].name == "quote\\\" back\\\\ tab\\u0009",
+            "names are JSON-escaped");
+    }
+
+    void CheckThreads()
+    {
+        Trace::Start(1024);
+        { MA_TRACE_SCOPE("Main"); }
+        std::thread worker([]
+            {
+                MA_TRACE_SCOPE("Worker");
+                MA_TRACE_SCOPE("WorkerInner");
+            });
+        worker.join();
+        Trace::Stop();
+
+        const ExportFile file = ExportAndRead();
+        bool separate = file.ok && file.events.size() == 6;
+        for (const Exported& ev : file.events)
+            separate &= (ev.name == "Main") == (ev.tid == file.events[0].tid);
+        Check(separate && Balanced(file), "each thread records under its own tid");
+    }
+
+    void CheckRestart()
+    {
+        Trace::Start(1024);
+        {
+            MA_TRACE_SCOPE("Straddling");
+            Trace::Stop();
+            Trace::Start(1024);
+            MA_TRACE_SCOPE("NewCapture");
+        }
+        Trace::Stop();
+
+        const ExportFile file = ExportAndRead();
+        Check(file.ok && CountNamed(file, "Straddling", 'E') == 0 && CountNamed(file, "Straddling", 'B') == 0,
+            "a scope open across Stop()/Start() leaves nothing in the new capture");
+        Check(file.ok && file.events.size() == 2 && Balanced(file), "the new capture's own spans are intact");
+
+        // Restarted while a scope from the old capture is still open, and
+        // that scope closes first.
+        Trace::Start(1024);
+        Trace::Scope* outer = new Trace::Scope("Old");
+        Trace::Stop();
+        Trace::Start(1024);
+        Trace::Scope* inner = new Trace::Scope("New");
+        delete outer;
+        delete inner;
+        Trace::Stop();
+        const ExportFile again = ExportAndRead();
+        Check(again.ok && again.events.size() == 2 && Balanced(again), "an old scope closing late is not exported");
+    }
+
+    void CheckFullBuffer()
+    {
+        // 65 slots leaves 1 for 'B' events past the 64-entry 'E' reserve.
+        Check(!Trace::Start(64), "a buffer no larger than the 'E' reserve is refused");
+        Trace::Start(65);
+        {
+            MA_TRACE_SCOPE("Kept");
+            for (int i = 0; i < 10; ++i)
+                MA_TRACE_SCOPE("Dropped");
+        }
+        Trace::Stop();
+
+        const ExportFile file = ExportAndRead();
+        Check(file.ok && Trace::GetDroppedCount() == 10 && CountNamed(file, "Dropped", 'B') == 0,
+            "spans past a full buffer are dropped and counted");
+        Check(file.ok && file.events.size() == 2 && Balanced(file), "recorded spans still close");
+    }
+}
+
+int main()
+{
+    CheckNesting();
+    CheckEscaping();
+    CheckThreads();
+    CheckRestart();
+    CheckFullBuffer();
+
+    std::printf("\n%d failed\n", s_failed);
+    return s_failed ? 1 : 0;
+}